@@ -0,0 +1,204 @@
+#ifndef AOT_H
+#define AOT_H
+
+#include "cpu.h"
+#include <array>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+
+// ======================================================================================
+//                                 AOT
+// Composants spécialisés pour le code généré par aotgen (tools/aotgen.cpp) :
+// - tous les paramètres de configuration (fréquence, largeur, taille, temps d'accès,
+//   rafraîchissement) sont des paramètres template, donc des constantes de compilation
+// - les programmes sont des tableaux constexpr d'Op
+// - chaque composant connaît le type exact de sa source : read() n'est jamais virtuel
+// Le comportement, cycle par cycle, est celui des classes de cpu.h, bus.h, mem.h et
+// display.h (mêmes sorties DISPLAY), sans compteurs de performance ni registry.
+// Header seul : un binaire généré se compile sans le reste des sources.
+// ======================================================================================
+
+namespace aot {
+
+// Opérandes émis en littéraux double, convertis à la compilation en value_t (value.h)
+struct Op {
+    OPCODE opcode;
+    value_t l, r;
+
+    constexpr Op(OPCODE op, double left, double right)
+        : opcode(op), l(Value::fromDouble(left)), r(Value::fromDouble(right)) {}
+};
+
+inline value_t compute(const Op& op) {
+    switch (op.opcode) {
+        case ADD: return Value::add(op.l, op.r);
+        case SUB: return Value::sub(op.l, op.r);
+        case MUL: return Value::mul(op.l, op.r);
+        case DIV:
+            if (!Value::isZero(op.r)) return Value::div(op.l, op.r);
+            std::cerr << "Error: Division by zero." << std::endl;
+            return value_t{};
+        case NOP: return value_t{};
+    }
+    return value_t{};
+}
+
+// Source absente de la plateforme générée (plateforme, type inconnu) : jamais de donnée
+struct NoSource {
+    DataValue read() { return DataValue(0.0, false); }
+};
+inline NoSource noSource;
+
+// ========================= CPU =========================
+template <int Frequency, int NCores, const Op* Code, std::size_t Len>
+struct Cpu {
+    std::size_t pc{0};
+    int activeCore{0};
+    std::deque<DataValue> registers;
+
+    void simulate() {
+        for (int i = 0; i < Frequency; ++i) {
+            OPCODE opcode = NOP;
+            value_t result{};
+            if (pc == Len) {
+                pc = 0;
+            } else {
+                opcode = Code[pc].opcode;
+                result = compute(Code[pc]);
+                ++pc;
+            }
+            if (opcode != NOP) {
+                registers.push_back(DataValue(result, true));
+            } else if (activeCore >= NCores - 1) {
+                activeCore = 0;
+                pc = 0;
+                break;
+            } else {
+                ++activeCore;
+            }
+        }
+    }
+
+    DataValue read() {
+        if (registers.empty()) return DataValue(0.0, false);
+        DataValue dv = registers.front();
+        registers.pop_front();
+        return dv;
+    }
+};
+
+// ========================= BUS =========================
+template <int Width, typename Source>
+struct Bus {
+    Source* source{nullptr};
+    std::deque<DataValue> pending;
+    std::deque<DataValue> ready;
+
+    void simulate() {
+        while (!pending.empty()) {
+            ready.push_back(pending.front());
+            pending.pop_front();
+        }
+        if (!source) return;
+        for (int i = 0; i < Width; ++i) {
+            DataValue data = source->read();
+            if (!data.valid) break;
+            pending.push_back(data);
+        }
+    }
+
+    DataValue read() {
+        if (ready.empty()) return DataValue(0.0, false);
+        DataValue dv = ready.front();
+        ready.pop_front();
+        return dv;
+    }
+};
+
+// ========================= MEMORY =========================
+template <std::size_t Size, int Access, typename Source>
+struct Memory {
+    static_assert(Size > 0 && Access > 0, "aotgen émet des paramètres déjà normalisés");
+
+    Source* source{nullptr};
+    std::uint64_t cycleCounter{0};
+    std::array<DataValue, Size> buffer{};
+    std::size_t head{0};
+    std::size_t tail{0};
+    std::size_t count{0};
+
+    void pushValue(const DataValue& dv) {
+        buffer[tail] = dv;
+        tail = (tail + 1) % Size;
+        if (count < Size) ++count;
+        else head = tail;
+    }
+
+    void simulate() {
+        ++cycleCounter;
+        if constexpr (Access > 1) {
+            if (cycleCounter % Access != 0) return;
+        }
+        if (!source) return;
+        for (;;) {
+            DataValue dv = source->read();
+            if (!dv.valid) break;
+            pushValue(dv);
+        }
+    }
+
+    DataValue read() {
+        if (count == 0) return DataValue(0.0, false);
+        DataValue dv = buffer[head];
+        head = (head + 1) % Size;
+        --count;
+        return dv;
+    }
+};
+
+// ========================= DISPLAY =========================
+template <int Refresh, typename Source, const char* SourceLabel,
+          ValueFormat Format = ValueFormat::GENERAL, int Precision = -1>
+struct Display {
+    Source* source{nullptr};
+    int callCounter{0};
+    std::string line;
+
+    void simulate() {
+        if (!source) return;
+        if (++callCounter < Refresh) return;
+        callCounter = 0;
+
+        line.assign("[DISPLAY] Source: ");
+        line += SourceLabel;
+        line += " -> ";
+        for (;;) {
+            DataValue val = source->read();
+            if (!val.valid) break;
+            appendValue(line, val.value, Format, Precision);
+        }
+        line += '\n';
+        std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+};
+
+// ========================= Main =========================
+// Nombre de cycles en argument, sinon lu sur l'entrée standard comme pour sim
+template <typename Platform>
+int run(Platform& platform, int argc, char* argv[]) {
+    long long cycles = 0;
+    if (argc > 1) {
+        cycles = std::atoll(argv[1]);
+    } else if (!(std::cin >> cycles)) {
+        std::cerr << "Usage: " << argv[0] << " [cycles]" << std::endl;
+        return 1;
+    }
+    for (long long i = 0; i < cycles; ++i) platform.simulate();
+    std::cout.flush();
+    return 0;
+}
+
+} // namespace aot
+
+#endif
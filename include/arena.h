@@ -0,0 +1,69 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ======================================================================================
+//                                 ARENA
+// Allocateur par blocs (bump allocator) : les allocations sont contiguës, dans l'ordre
+// où elles sont faites, et ne sont libérées qu'avec l'arena entière.
+// Méthodes pertinentes :
+//   - make<T>(args...) : construit un objet dans l'arena, détruit par ~Arena()
+//                        (ordre inverse de création)
+//   - allocateArray<T>(n) : tableau de n T construits par défaut, sans destructeur
+//                           (réservé aux types trivialement destructibles)
+// Une allocation plus grande qu'un bloc reçoit son propre bloc.
+// ======================================================================================
+
+class Arena {
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+        std::size_t used;
+    };
+    struct Destructor {
+        void (*destroy)(void*);
+        void* object;
+    };
+
+    std::vector<Chunk> chunks;
+    std::vector<Destructor> destructors;
+    std::size_t chunkSize;
+
+public:
+    explicit Arena(std::size_t chunkBytes = 64 * 1024);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t align);
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors.push_back({[](void* p) { static_cast<T*>(p)->~T(); }, object});
+        }
+        return object;
+    }
+
+    template <typename T>
+    T* allocateArray(std::size_t n) {
+        static_assert(std::is_trivially_destructible_v<T>, "allocateArray : pas de destructeur appelé");
+        T* first = static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+        for (std::size_t i = 0; i < n; ++i) new (first + i) T();
+        return first;
+    }
+
+    std::size_t bytesUsed() const;
+    std::size_t bytesReserved() const;
+};
+
+#endif
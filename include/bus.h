@@ -2,6 +2,7 @@
 #define BUS_H__
 
 #include "lib.h"
+#include "fifo.h"
 
 // ======================================================================================
 //                           BUS
@@ -17,21 +18,65 @@ private:
     int width{1};
     int readCount{0};
 
-    ReadableComponent* source{nullptr};
+    SourceHandle source;
 
-    std::queue<DataValue> pending;
-    std::queue<DataValue> ready;
+    Fifo<DataValue> pending;
+    Fifo<DataValue> ready;
 
 public:
     BUS(const std::string& lbl = "BUS");
     virtual ~BUS();
 
     void bindSource(const std::string& sourceLabel);
+    void bindSource(ReadableComponent* src) { source = src; }
+    ReadableComponent* getSource() const { return source.get(); }
     std::string getSourceLabel() const;
 
+    int getWidth() const { return width; }
+    int getReadCount() const { return readCount; }
+    std::size_t getReadySize() const { return ready.size(); }
+    std::size_t getPendingSize() const { return pending.size(); }
+    // Valeurs lues sur la source au dernier cycle (watchpoints, cf until.h)
+    const Fifo<DataValue>& getPending() const { return pending; }
+    void setWidth(int w) { width = w; }
+
+    // Files pending/ready dans l'arena de la plateforme
+    void placeIn(Arena& arena) {
+        std::size_t w = static_cast<std::size_t>(width > 0 ? width : 1);
+        pending.placeIn(arena, w);
+        ready.placeIn(arena, 2 * w);
+    }
+
     void simulate() override;
-    DataValue read() override;
+    void simulate(std::uint64_t cycles) override;
+    // Sans latence : pending passe dans ready, puis jusqu'à width valeurs par cycle sont
+    // lues directement dans ready
+    void fastForward(std::uint64_t cycles) override;
+
+    // BUS coupé entre deux processus (partition.h) : fetch() est l'étape 2 de simulate()
+    // (lecture de la source, au plus width valeurs dans out), faite dans le processus de
+    // la source ; deliver() est l'étape 1 du cycle suivant (pending -> ready), faite dans
+    // le processus du BUS avec les valeurs reçues
+    std::size_t fetch(DataValue* out);
+    void deliver(const DataValue* values, std::size_t n);
+
+    // Dans le header pour être inlinée par SourceHandle (dispatch.h)
+    DataValue read() override {
+        if (ready.empty()) {
+            STATS_ONLY(++stats.emptyReads;)
+            return DataValue(0.0, false);
+        }
+        DataValue data = ready.front();
+        ready.pop();
+        readCount++;
+        STATS_ONLY(++stats.produced;)
+        return data;
+    }
+
+    bool hasData() const override { return !ready.empty(); }
+    std::uint64_t nextWakeup(std::uint64_t now) const override;
     void printInfo() const override;
+    bool setParam(const std::string& key, const std::string& value) override;
 
     bool loadFromFile(const std::string& filename) override;
 };
@@ -0,0 +1,79 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ======================================================================================
+//                                 CLOCK
+// Domaine d'horloge d'un composant ou d'une sous-plateforme, relatif à l'horloge de sa
+// plateforme parente (la plateforme racine définit l'horloge de base : un cycle de sim)
+// Clé de config CLOCK :
+//   CLOCK: P [PHASE]      un front tous les P cycles parents, au cycle PHASE (0 <= PHASE < P)
+//   CLOCK: N/D [PHASE]    N fronts tous les D cycles parents (N <= D), répartis
+//                         régulièrement, motif décalé de PHASE cycles parents
+// Un domaine n'est jamais plus rapide que son parent : l'horloge de base est celle du
+// domaine le plus rapide, les autres en sont des fractions. Un composant ne reçoit
+// simulate() qu'à ses fronts (au plus un par cycle parent) : ses compteurs internes
+// (FREQUENCY, ACCESS, REFRESH...) comptent ses propres cycles. Une sous-plateforme
+// multiplie l'horloge de ses composants par la sienne (ClockChain).
+// ======================================================================================
+
+struct Clock {
+    std::uint32_t num{1};
+    std::uint32_t den{1};
+    std::uint32_t phase{0};
+
+    bool isBase() const { return num == 1 && den == 1 && phase == 0; }
+
+    // Fronts pendant les m premiers cycles parents
+    std::uint64_t ticks(std::uint64_t m) const {
+        if (isBase()) return m;
+        const unsigned __int128 off = den - 1 - phase;
+        return static_cast<std::uint64_t>((m + off) * num / den - off * num / den);
+    }
+
+    // Fronts au cycle parent t (0 ou 1)
+    std::uint64_t edgesAt(std::uint64_t t) const { return ticks(t + 1) - ticks(t); }
+
+    // Plus petit m tel que ticks(m) >= k (nombre de cycles parents pour k fronts)
+    std::uint64_t parentCyclesFor(std::uint64_t k) const {
+        if (isBase()) return k;
+        const unsigned __int128 off = den - 1 - phase;
+        const unsigned __int128 target = k + off * num / den;
+        const unsigned __int128 m = (target * den + num - 1) / num;
+        if (m <= off) return 0;
+        return m - off >= UINT64_MAX ? UINT64_MAX : static_cast<std::uint64_t>(m - off);
+    }
+
+    // Analyse la valeur d'une clé CLOCK ; false (horloge inchangée) si elle est invalide
+    bool parse(const std::string& value);
+    std::string toString() const;
+};
+
+// Horloge effective d'un composant vue de l'horloge de base : composition des horloges
+// des sous-plateformes englobantes puis de la sienne (les horloges de base sont omises)
+struct ClockChain {
+    std::vector<Clock> clocks; // de la plus externe à celle du composant
+
+    void push(const Clock& c) { if (!c.isBase()) clocks.push_back(c); }
+    bool isBase() const { return clocks.empty(); }
+
+    // Fronts du composant pendant les m premiers cycles de base
+    std::uint64_t ticks(std::uint64_t m) const {
+        for (const Clock& c : clocks) m = c.ticks(m);
+        return m;
+    }
+    std::uint64_t edgesAt(std::uint64_t t) const { return ticks(t + 1) - ticks(t); }
+
+    // Cycle de base du front d'indice k (le (k+1)-ième), NEVER si k == NEVER
+    std::uint64_t cycleOfTick(std::uint64_t k) const {
+        if (k == UINT64_MAX) return k;
+        std::uint64_t m = k + 1;
+        for (auto it = clocks.rbegin(); it != clocks.rend() && m != UINT64_MAX; ++it) m = it->parentCyclesFor(m);
+        return m == UINT64_MAX ? m : m - 1;
+    }
+};
+
+#endif
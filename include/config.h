@@ -0,0 +1,88 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include "lib.h"
+#include "cpu.h"
+#include <mutex>
+#include <unordered_map>
+
+// ======================================================================================
+//                                 CONFIGFILE
+// Fichier de configuration parsé : les paires "CLE: valeur" dans l'ordre du fichier
+// (mêmes règles que l'ancien parsing ligne par ligne : lignes vides et lignes sans
+// valeur ignorées, clé et valeur trimées)
+// ======================================================================================
+
+struct ConfigFile {
+    std::vector<std::pair<std::string, std::string>> entries;
+    bool image{false}; // image binaire de plateforme (cf image.h) : ni lue en entier, ni parsée
+
+    // Première valeur associée à key, "" si absente
+    std::string get(const std::string& key) const {
+        for (const auto& e : entries) {
+            if (e.first == key) return e.second;
+        }
+        return "";
+    }
+};
+
+// ======================================================================================
+//                                 CONFIGCACHE
+// Cache global (un par process) des fichiers de config et des programmes parsés
+// - chaque chemin n'est lu qu'une seule fois
+// - le résultat parsé est indexé par le contenu : deux fichiers identiques partagent
+//   le même ConfigFile / la même liste d'instructions
+// - les listes d'instructions sont de plus indexées par les instructions elles-mêmes
+//   (internProgram) : un programme identique, écrit autrement ou venu d'une image de
+//   plateforme, n'a qu'une seule copie, partagée par tous les CPU (cf Program)
+// - prefetch() parcourt l'arbre d'une plateforme et parse les fichiers en parallèle
+//   sur un ThreadPool, niveau par niveau (les COMPONENT d'un niveau sont découverts
+//   en lisant les PLATFORM du niveau précédent)
+// Usage : les loadFromFile des composants passent par getConfig()/getProgram()
+//         au lieu d'ouvrir eux-mêmes leur fichier
+// ======================================================================================
+
+class ConfigCache {
+private:
+    static inline std::mutex mtx;
+    static inline unsigned n_threads{0}; // 0 = choix automatique
+
+    // chemin -> résultat parsé (nullptr si le fichier n'a pas pu être ouvert)
+    static inline std::unordered_map<std::string, std::shared_ptr<const ConfigFile>> configByPath;
+    static inline std::unordered_map<std::string, std::shared_ptr<const InstructionList>> programByPath;
+
+    // contenu brut -> résultat parsé
+    static inline std::unordered_map<std::string, std::shared_ptr<const ConfigFile>> configByContent;
+    static inline std::unordered_map<std::string, std::shared_ptr<const InstructionList>> programByContent;
+    // instructions encodées (opcode et opérandes) -> image partagée
+    static inline std::unordered_map<std::string, std::shared_ptr<const InstructionList>> programByCode;
+
+    static bool readFile(const std::string& path, std::string& content);
+    static std::shared_ptr<const ConfigFile> parseConfig(const std::string& content);
+    static std::shared_ptr<const InstructionList> parseProgram(const std::string& content);
+    static std::shared_ptr<const InstructionList> internLocked(std::shared_ptr<const InstructionList> code);
+
+public:
+    static std::shared_ptr<const ConfigFile> getConfig(const std::string& path);
+    // Type d'un fichier de composant, depuis le cache : "IMAGE" pour une image de
+    // plateforme, sinon la ligne TYPE, et le nom du fichier en dernier recours pour les
+    // configs sans TYPE ; "" si inconnu. Même règle pour le chargement et prefetch()
+    static std::string componentType(const std::string& path);
+    static std::shared_ptr<const InstructionList> getProgram(const std::string& path);
+    // Image partagée de ces instructions : celle déjà connue si le contenu est identique
+    static std::shared_ptr<const InstructionList> internProgram(InstructionList code);
+    // Nombre de programmes distincts en cache
+    static std::size_t programCount();
+
+    static void prefetch(const std::string& rootFile);
+
+    // Relit le fichier (rechargement à chaud, cf reload.h) et remplace l'entrée du cache ;
+    // nullptr si le fichier ne s'ouvre plus (l'ancienne entrée est alors gardée)
+    static std::shared_ptr<const ConfigFile> reloadConfig(const std::string& path);
+
+    static bool isCached(const std::string& path);
+    static void setThreads(unsigned n) { n_threads = n; }
+    static void clear();
+};
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include "lib.h"
+#include "dispatch.h"
+#include "fifo.h"
+#include <coroutine>
+
+// ======================================================================================
+//                           COROUTINE COMPONENT
+// Classe de base (optionnelle) pour les composants dont le comportement s'écrit comme
+// une coroutine C++20 plutôt qu'avec des compteurs de cycles :
+//
+//     Behavior behavior() override {
+//         for (;;) {
+//             DataValue v = co_await input();   // attend une donnée de la source
+//             co_await cycles(latency);         // attend latency cycles
+//             emit(v);                          // visible par read() dès maintenant
+//         }
+//     }
+//
+// - la coroutine démarre au premier simulate() ; un simulate() ne la reprend que si la
+//   condition attendue est remplie (nombre de cycles écoulé, donnée disponible), sinon
+//   il ne fait qu'avancer le compteur de cycles
+// - nextWakeup() renvoie le cycle de reprise exact, NEVER en attente de donnée : le
+//   Scheduler (idle skipping) réveille le composant quand sa source a des données
+// - simulate(n) (quantum) saute directement jusqu'au cycle de reprise
+// - les sorties passent par emit() dans une Fifo lue par read()
+// input() lit la source dès que hasData() est vrai : pour une source dont hasData() n'est
+// pas fiable (défaut true), la valeur reprise peut être invalide et doit être testée.
+// ======================================================================================
+
+class CoroutineComponent : public ReadableComponent {
+public:
+    // Type de retour de behavior() : possède la coroutine, démarrée suspendue
+    class Behavior {
+    public:
+        struct promise_type {
+            Behavior get_return_object() { return Behavior(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        Behavior() = default;
+        explicit Behavior(std::coroutine_handle<promise_type> h) : handle(h) {}
+        Behavior(Behavior&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+        Behavior& operator=(Behavior&& other) noexcept;
+        Behavior(const Behavior&) = delete;
+        Behavior& operator=(const Behavior&) = delete;
+        ~Behavior();
+
+        bool done() const { return !handle || handle.done(); }
+        void resume() { handle.resume(); }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+    };
+
+private:
+    enum class Wait { START, CYCLES, DATA, DONE };
+
+    Behavior coroutine;
+    Wait wait{Wait::START};
+    std::uint64_t cycle{0};       // cycles simulés par ce composant
+    std::uint64_t wakeAt{0};      // Wait::CYCLES : cycle de reprise
+    std::string sourceLabelStored;
+
+    Fifo<DataValue> output;
+
+    bool ready();                 // condition d'attente remplie au cycle courant
+    void step();
+
+protected:
+    SourceHandle source;
+
+    virtual Behavior behavior() = 0;
+
+    // Awaitables utilisables dans behavior()
+    struct CyclesAwaiter {
+        CoroutineComponent* self;
+        std::uint64_t n;
+        bool await_ready() const noexcept { return n == 0; }
+        void await_suspend(std::coroutine_handle<>) noexcept {
+            self->wait = Wait::CYCLES;
+            self->wakeAt = self->cycle + n;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct InputAwaiter {
+        CoroutineComponent* self;
+        bool await_ready() const { return self->source && self->source.hasData(); }
+        void await_suspend(std::coroutine_handle<>) noexcept { self->wait = Wait::DATA; }
+        DataValue await_resume() { return self->take(); }
+    };
+
+    CyclesAwaiter cycles(std::uint64_t n) { return CyclesAwaiter{this, n}; }
+    InputAwaiter input() { return InputAwaiter{this}; }
+
+    // Lecture immédiate de la source (donnée invalide si elle est vide)
+    DataValue take();
+    // Vrai si la source a une donnée prête (pour vider un burst sans attendre)
+    bool sourceHasData() const { return source && source.hasData(); }
+    void emit(const DataValue& v);
+    std::uint64_t now() const { return cycle; }
+
+    // Clés SOURCE, LABEL et CLOCK communes ; renvoie false pour une clé inconnue
+    bool parseCommonKey(const std::string& key, const std::string& value);
+
+public:
+    CoroutineComponent(const std::string& lbl = "") : ReadableComponent(lbl) {}
+    ~CoroutineComponent() override = default;
+
+    // Nom du type pour les rapports (stats, profiler), TYPE du fichier de config
+    virtual const char* typeName() const = 0;
+
+    void bindSource(const std::string& lbl);
+    void bindSource(ReadableComponent* src);
+    ReadableComponent* getSource();
+    std::string getSourceLabel() const;
+
+    void simulate() override;
+    void simulate(std::uint64_t n) override;
+    DataValue read() override;
+
+    bool hasData() const override { return !output.empty(); }
+    std::uint64_t nextWakeup(std::uint64_t now) const override;
+    void skipCycles(std::uint64_t n) override { cycle += n; }
+
+    std::size_t getOutputSize() const { return output.size(); }
+    void placeIn(Arena& arena) { output.placeIn(arena, 16); }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define CPU_H__
 
 #include "lib.h"
+#include "fifo.h"
 
 enum OPCODE {
     NOP,
@@ -14,37 +15,71 @@ enum OPCODE {
 
 struct Instruction {
 private:
-    double operand_l;
-    double operand_r;
+    value_t operand_l;
+    value_t operand_r;
 
 public:
     OPCODE opcode;
-    Instruction(OPCODE op = NOP, double l = 0.0, double r = 0.0)
+    Instruction(OPCODE op = NOP, value_t l = value_t{}, value_t r = value_t{})
         : opcode(op), operand_l(l), operand_r(r) {}
 
-    double compute();  // implemented in cpu.cpp
+    value_t compute();  // implemented in cpu.cpp (opérations de ValueTraits, cf value.h)
+
+    value_t left() const { return operand_l; }
+    value_t right() const { return operand_r; }
 };
 
 
+// Liste d'instructions décodées, immuable une fois publiée par ConfigCache
+using InstructionList = std::vector<Instruction>;
+
+// ======================================================================================
+//                           PROGRAM
+// Les instructions sont une image immuable du cache global (ConfigCache::internProgram),
+// indexée par leur contenu et partagée par référence entre tous les CPU, toutes les
+// plateformes et toutes les simulations du process : la mémoire dépend du nombre de
+// programmes distincts, pas du nombre de CPU. Seul le program counter est propre à
+// chaque Program (copie : même image, pc recopié).
+// ======================================================================================
 struct Program {
 private:
-    std::list<Instruction> instructions;
-    std::list<Instruction>::iterator pc = instructions.begin(); // program counter, pointant sur l'instruction courante
+    std::shared_ptr<const InstructionList> image; // nullptr tant qu'aucun programme n'est chargé
+    const Instruction* code{nullptr};
+    std::size_t length{0};
+    std::size_t pc{0}; // program counter, index de l'instruction courante
 
 public:
     Instruction compute();       // implemented in cpu.cpp
 
     void load(const std::string &filename); //implemented in cpu.cpp
+
+    // Remplace le programme par n instructions déjà décodées (image de plateforme),
+    // partagées avec tout programme identique déjà connu du cache ; implemented in cpu.cpp
+    void assign(const Instruction* first, std::size_t n);
+    // Idem avec une image déjà publiée par ConfigCache
+    void assign(std::shared_ptr<const InstructionList> shared) {
+        image = std::move(shared);
+        code = image ? image->data() : nullptr;
+        length = image ? image->size() : 0;
+        reset();
+    }
+
+    const Instruction* begin() const { return code; }
+    const Instruction* end() const { return code + length; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    // Image partagée (comparaison d'identité, comptage des références)
+    const std::shared_ptr<const InstructionList>& getImage() const { return image; }
     
     void reset(){
-        pc = instructions.begin();
+        pc = 0;
     };
 };
 
 
 struct Register {
 private:
-    std::vector<DataValue> fifo;
+    Fifo<DataValue> fifo;
 public:
     Register() = default;
 
@@ -53,12 +88,24 @@ public:
     // Definition des methodes utiles quand on travaille avec un FIFO. Definitions simples donc dans le header
 
     void push(const DataValue &v) {
-        fifo.push_back(v);
+        fifo.push(v);
     }
 
     const DataValue* peek() const {
         return fifo.empty() ? nullptr : &fifo.front();
     }
+
+    std::size_t size() const {
+        return fifo.size();
+    }
+
+    bool empty() const {
+        return fifo.empty();
+    }
+
+    void placeIn(Arena& arena, std::size_t reserve) {
+        fifo.placeIn(arena, reserve);
+    }
 };
 
 class CPU : public ReadableComponent {
@@ -69,7 +116,9 @@ class CPU : public ReadableComponent {
         ~CPU() override = default;
 
         DataValue read() override{
-            return registers.pop();
+            DataValue dv = registers.pop();
+            STATS_ONLY(if (dv.valid) ++stats.produced; else ++stats.emptyReads;)
+            return dv;
         };
 
         bool loadFromFile(const std::string &filename) override;
@@ -82,9 +131,25 @@ class CPU : public ReadableComponent {
         void setNCores(int n){n_cores = n;}
         void setActiveCore(int core){active_core = core;}
 
+        int getFrequency() const {return frequency;}
+        int getNCores() const {return n_cores;}
+        std::size_t getRegisterDepth() const {return registers.size();}
+        Program& getProgram() {return program;}
+
+        // Registre de sortie dans l'arena de la plateforme (le programme reste partagé)
+        void placeIn(Arena& arena) {
+            registers.placeIn(arena, static_cast<std::size_t>(frequency > 0 ? frequency : 1) * 2);
+        }
+        const Program& getProgram() const {return program;}
+
         void printInfo() const override;
+        bool setParam(const std::string& key, const std::string& value) override;
 
         void simulate() override;  // definition de la methode virtuelle de component, implementee dans cpu.cpp
+        void simulate(std::uint64_t cycles) override;
+
+        bool hasData() const override {return !registers.empty();}
+        std::uint64_t nextWakeup(std::uint64_t now) const override {return frequency > 0 ? now + 1 : NEVER;}
 
     private:
         int frequency;
@@ -0,0 +1,55 @@
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include "lib.h"
+#include "cpu.h"
+#include "bus.h"
+#include "mem.h"
+
+// ======================================================================================
+//                                 DISPATCH
+// Définitions inline de SourceHandle::read()/hasData() (cf lib.h) : elles ont besoin des
+// types complets, à inclure dans les .cpp qui lisent leur source dans le chemin chaud.
+// L'appel qualifié (CPU::read()) n'est pas virtuel : le corps est inliné dans l'appelant.
+// ======================================================================================
+
+inline DataValue SourceHandle::read() const {
+    switch (kind) {
+        case Kind::CPU: return static_cast<CPU*>(ptr)->CPU::read();
+        case Kind::BUS: return static_cast<BUS*>(ptr)->BUS::read();
+        case Kind::MEMORY: return static_cast<Memory*>(ptr)->Memory::read();
+        case Kind::VIRTUAL: break;
+    }
+    return ptr->read();
+}
+
+inline bool SourceHandle::hasData() const {
+    switch (kind) {
+        case Kind::CPU: return static_cast<const CPU*>(ptr)->CPU::hasData();
+        case Kind::BUS: return static_cast<const BUS*>(ptr)->BUS::hasData();
+        case Kind::MEMORY: return static_cast<const Memory*>(ptr)->Memory::hasData();
+        case Kind::VIRTUAL: break;
+    }
+    return ptr->hasData();
+}
+
+inline std::size_t SourceHandle::readBatch(value_t* out, std::size_t max) const {
+    switch (kind) {
+        case Kind::MEMORY: return static_cast<Memory*>(ptr)->Memory::readBatch(out, max);
+        case Kind::CPU:
+        case Kind::BUS: {
+            // Boucle sur le read() inliné plutôt que sur le read() virtuel du défaut
+            std::size_t n = 0;
+            while (n < max) {
+                DataValue v = read();
+                if (!v.valid) break;
+                out[n++] = v.value;
+            }
+            return n;
+        }
+        case Kind::VIRTUAL: break;
+    }
+    return ptr->readBatch(out, max);
+}
+
+#endif
@@ -2,17 +2,38 @@
 #define DISPLAY_H
 
 #include "lib.h"
+#include <functional>
 
 // ======================================================================================
 //                                   DISPLAY
 // Affiche les données d'une source selon refreshRate
+// Sortie : ligne "[DISPLAY] Source: ..." sur std::cout par défaut ; avec setOutput(), les
+// valeurs lues à chaque rafraîchissement sont passées à la callback (bibliothèque,
+// cf simulation.h), sans rien écrire sur la console
+// À chaque rafraîchissement la source est vidée par blocs (readBatch) et la ligne est
+// formatée avec std::to_chars dans un buffer réutilisé, écrit en une fois.
+// Config : FORMAT GENERAL|SHORTEST|FIXED|HEX (défaut GENERAL, cf value.h),
+//          PRECISION n (défaut : celui du format, 6 pour GENERAL comme operator<<)
 // ======================================================================================
 
 class Display : public Component {
+public:
+    using Output = std::function<void(const Display& display, const value_t* values, std::size_t n)>;
+
 private:
     int refreshRate{1};
     int callCounter{0};
-    ReadableComponent* source{nullptr};
+    SourceHandle source;
+
+    ValueFormat format{ValueFormat::GENERAL};
+    int precision{-1}; // < 0 : défaut du format
+
+    Output output;
+    std::vector<value_t> values; // valeurs du rafraîchissement en cours
+    std::string line;            // ligne formatée, réutilisée d'un rafraîchissement à l'autre
+
+    std::size_t drain();
+    void writeLine();
 
 public:
     Display() = default;
@@ -23,14 +44,31 @@ public:
     int getRefreshRate() const;
     void setRefreshRate(int rate);
 
+    ValueFormat getFormat() const { return format; }
+    void setFormat(ValueFormat fmt) { format = fmt; }
+    int getPrecision() const { return precision; }
+    void setPrecision(int digits) { precision = digits; }
+
     void bindSource(const std::string& sourceLabel);
+    void bindSource(ReadableComponent* src) { source = src; }
+    ReadableComponent* getSource() const { return source.get(); }
     std::string getSourceLabel() const;
 
+    // Callback appelée à chaque rafraîchissement ; une callback vide rétablit std::cout
+    void setOutput(Output out) { output = std::move(out); }
+
     void printInfo() const override;
 
     bool loadFromFile(const std::string& filename) override;
+    bool setParam(const std::string& key, const std::string& value) override;
 
     void simulate() override;
+    void simulate(std::uint64_t cycles) override;
+    // Vide la source à chaque rafraîchissement atteint, sans rien afficher
+    void fastForward(std::uint64_t cycles) override;
+
+    std::uint64_t nextWakeup(std::uint64_t now) const override;
+    void skipCycles(std::uint64_t n) override;
 };
 
 #endif
@@ -0,0 +1,40 @@
+#ifndef DMA_H
+#define DMA_H
+
+#include "coroutine.h"
+
+// ======================================================================================
+//                                   DMA
+// Moteur DMA d'exemple, écrit comme une coroutine (cf coroutine.h) :
+// attend une donnée de la source, la complète en burst avec ce qui est déjà disponible
+// (jusqu'à BURST valeurs), attend LATENCY cycles de transfert, puis rend le burst
+// lisible d'un bloc par read(). Aucun compteur de cycles à la main.
+// Config : TYPE: DMA, LABEL, SOURCE, BURST (1), LATENCY (1)
+// ======================================================================================
+
+class Dma : public CoroutineComponent {
+private:
+    int burst{1};
+    int latency{1};
+    std::uint64_t transfers{0};
+
+protected:
+    Behavior behavior() override;
+
+public:
+    Dma(const std::string& lbl = "DMA") : CoroutineComponent(lbl) {}
+
+    const char* typeName() const override { return "DMA"; }
+
+    int getBurst() const { return burst; }
+    int getLatency() const { return latency; }
+    std::uint64_t getTransfers() const { return transfers; }
+    void setBurst(int b) { burst = b > 0 ? b : 1; }
+    void setLatency(int l) { latency = l > 0 ? l : 0; }
+
+    bool loadFromFile(const std::string& filename) override;
+    bool setParam(const std::string& key, const std::string& value) override;
+    void printInfo() const override;
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef FIFO_H
+#define FIFO_H
+
+#include "arena.h"
+#include <cstddef>
+#include <vector>
+
+// ======================================================================================
+//                                 FIFO
+// File circulaire à capacité puissance de 2 (remplace std::queue / std::vector avec
+// erase(begin)) : push et pop en O(1), éléments contigus, aucune allocation en régime
+// établi. Le stockage est sur le tas, ou dans une Arena après placeIn() ; la file grandit
+// (x2) si elle déborde, toujours sur le tas : une arena ne libère rien avant sa
+// destruction, chaque croissance y laisserait l'ancien tableau.
+// ======================================================================================
+
+template <typename T>
+class Fifo {
+private:
+    T* slots{nullptr};
+    std::size_t mask{0};   // capacité - 1
+    std::size_t head{0};
+    std::size_t count{0};
+    std::vector<T> heap;   // stockage quand la file n'est pas dans une arena
+    Arena* arena{nullptr};
+
+    void grow(std::size_t minCapacity) {
+        std::size_t capacity = 4;
+        while (capacity < minCapacity) capacity *= 2;
+
+        T* fresh;
+        std::vector<T> freshHeap;
+        if (arena) {
+            fresh = arena->allocateArray<T>(capacity);
+        } else {
+            freshHeap.resize(capacity);
+            fresh = freshHeap.data();
+        }
+        for (std::size_t i = 0; i < count; ++i) fresh[i] = slots[(head + i) & mask];
+        heap.swap(freshHeap);
+        slots = fresh;
+        mask = capacity - 1;
+        head = 0;
+    }
+
+public:
+    Fifo() = default;
+
+    // Copie sur le tas, même si l'original est dans une arena (composants copiés hors
+    // plateforme, cf testdebug)
+    Fifo(const Fifo& other) { *this = other; }
+    Fifo& operator=(const Fifo& other) {
+        if (this == &other) return *this;
+        arena = nullptr;
+        heap.clear();
+        slots = nullptr;
+        mask = 0;
+        head = 0;
+        count = 0;
+        if (other.count) {
+            grow(other.count);
+            for (std::size_t i = 0; i < other.count; ++i) slots[i] = other[i];
+            count = other.count;
+        }
+        return *this;
+    }
+
+    void push(const T& value) {
+        if (!slots || count > mask) {
+            arena = nullptr; // capacité de placeIn() dépassée : la suite sur le tas
+            grow(slots ? (mask + 1) * 2 : 4);
+        }
+        slots[(head + count) & mask] = value;
+        ++count;
+    }
+
+    const T& front() const { return slots[head]; }
+    void pop() {
+        head = (head + 1) & mask;
+        --count;
+    }
+
+    // i-ème élément depuis la tête (affichage)
+    const T& operator[](std::size_t i) const { return slots[(head + i) & mask]; }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Déplace le stockage dans l'arena, avec au moins reserve places
+    void placeIn(Arena& a, std::size_t reserve) {
+        arena = &a;
+        grow(reserve > count ? reserve : count);
+    }
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <cstdint>
+
+// ======================================================================================
+//                                 PLATFORM IMAGE
+// Format binaire "compilé" d'une plateforme : toute la hiérarchie aplatie dans un seul
+// fichier, liens déjà résolus et programmes déjà décodés.
+// Produit par l'outil mkimage (Platform::saveImage), relu par Platform::loadImage via
+// un seul mmap : les tables sont lues sur place, seuls les pointeurs source sont
+// reconstruits à partir des index (aucun parsing de texte, aucune recherche par label).
+//
+// Disposition du fichier (tous les offsets sont relatifs au début du fichier) :
+//   ImageHeader | ImageNode[n_nodes] | ImageProgram[n_programs]
+//               | ImageInstruction[n_instructions] | table des chaînes (labels)
+// Les noeuds sont rangés en pré-ordre : une plateforme, puis ses CPU, MEMORY, BUS,
+// DMA, DISPLAY, puis ses sous-plateformes (l'ordre de simulate() est donc conservé).
+// Le noeud 0 est la plateforme racine.
+// ======================================================================================
+
+namespace image {
+
+constexpr char MAGIC[8] = {'P', 'R', 'O', 'J', 'C', 'I', 'M', 'G'};
+constexpr std::uint32_t VERSION = 3; // 2 : domaines d'horloge, 3 : format DISPLAY
+
+enum NodeKind : std::uint32_t {
+    NODE_PLATFORM = 0,
+    NODE_CPU = 1,
+    NODE_MEMORY = 2,
+    NODE_BUS = 3,
+    NODE_DISPLAY = 4,
+    NODE_DMA = 5
+};
+
+struct ImageHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t n_nodes;
+    std::uint32_t n_programs;
+    std::uint32_t n_instructions;
+    std::uint64_t nodes_offset;
+    std::uint64_t programs_offset;
+    std::uint64_t instructions_offset;
+    std::uint64_t strings_offset;
+    std::uint64_t strings_size;
+};
+
+// Borne des paramètres relus (taille MEMORY, fréquence, largeur...) : une image corrompue
+// ne doit pas provoquer d'allocation démesurée
+constexpr std::int64_t MAX_PARAM = std::int64_t(1) << 24;
+
+// Paramètres selon kind :
+//   CPU     : p0 = frequency, p1 = n_cores, p2 = index du programme (-1 si aucun)
+//   MEMORY  : p0 = size, p1 = accessTime
+//   BUS     : p0 = width
+//   DISPLAY : p0 = refreshRate, p1 = format (ValueFormat), p2 = precision
+//   DMA     : p0 = burst, p1 = latency
+struct ImageNode {
+    std::uint32_t kind;
+    std::int32_t parent;        // index du noeud plateforme parent, -1 pour la racine
+    std::int32_t source;        // index du noeud source, -1 si aucune (plateforme : OUTPUT)
+    std::uint32_t label_offset; // dans la table des chaînes
+    std::uint32_t label_size;
+    std::uint32_t reserved;
+    std::int64_t p0;
+    std::int64_t p1;
+    std::int64_t p2;
+    std::uint32_t clock_num;    // CLOCK du noeud (clock.h), 1/1 phase 0 par défaut
+    std::uint32_t clock_den;
+    std::uint32_t clock_phase;
+    std::uint32_t reserved2;
+};
+
+struct ImageProgram {
+    std::uint32_t first; // index de la première instruction
+    std::uint32_t count;
+};
+
+// Opérandes toujours en double, quel que soit value_t (value.h) : une image se relit
+// dans toutes les builds (entiers exacts jusqu'à 2^53)
+struct ImageInstruction {
+    std::int32_t opcode;
+    std::int32_t reserved;
+    double operand_l;
+    double operand_r;
+};
+
+} // namespace image
+
+#endif
@@ -9,18 +9,28 @@
 #include <sstream>
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+#include "stats.h"
+#include "clock.h"
+#include "log.h"
+#include "value.h"
+
+// Cycle "jamais" pour Component::nextWakeup() : composant endormi jusqu'à ce que sa source ait des données
+constexpr std::uint64_t NEVER = UINT64_MAX;
 
 
 // ======================================================================================
 //                           DataValue
 // Structure pour représenter une valeur de donnée avec son état de validité
-// Utilisée pour les ReadableComponent
+// Utilisée pour les ReadableComponent ; type de la valeur fixé par la build (value.h)
 // ======================================================================================
 struct DataValue {
-    double value;
+    value_t value;
     bool valid;
 
-    DataValue(double v = 0.0, bool ok = false)
+    DataValue(value_t v = value_t{}, bool ok = false)
         : value(v), valid(ok) {}
 };
 
@@ -29,14 +39,61 @@ struct DataValue {
 // Classe de base, abstraite, que tous les composants dont tous les components hériteront
 // ======================================================================================
 class Component {
+protected:
+    STATS_ONLY(ComponentStats stats;) // compteurs de performance, absents en release
+    Clock clock; // domaine d'horloge (clock.h), par défaut celui de la plateforme parente
+
 public:
     virtual ~Component() = default; //Destructeur virtuel pour une meilleure gestion de la mémoire
 
     virtual void simulate() = 0; // Méthode virtuelle pure que tous les components doivent implémenter
 
+    // Quantum stepping : avance de n cycles en un seul appel, en supposant que les entrées
+    // (sources) ne changent pas pendant le quantum. Par défaut : n appels à simulate().
+    // Les classes dérivées qui la redéfinissent doivent aussi redéfinir simulate() (masquage).
+    virtual void simulate(std::uint64_t cycles) {
+        for (std::uint64_t i = 0; i < cycles; ++i) simulate();
+    }
+
+    // Fast-forward fonctionnel (simulation échantillonnée, cf sampling.h) : avance de n
+    // cycles en ne gardant que le flot des données, sans latence ni affichage.
+    // Par défaut : quantum stepping, déjà sans latence pour les composants sans entrée.
+    virtual void fastForward(std::uint64_t cycles) { simulate(cycles); }
+
     virtual bool loadFromFile(const std::string& filename) = 0; //Méthode virtuelle pure pour charger la config depuis un fichier
 
     virtual void printInfo() const = 0; //Utile pour debug, "const" permet de s'assurer que la méthode ne modifie pas l'objet
+
+    // Idle skipping (cf scheduler.h), appelée juste après simulate() au cycle now :
+    // cycle du prochain simulate() utile si les entrées ne changent pas, NEVER si le
+    // composant n'a rien à faire tant que sa source n'a pas de nouvelles données.
+    // Par défaut : simulé à chaque cycle.
+    virtual std::uint64_t nextWakeup(std::uint64_t now) const { return now + 1; }
+
+    // Avance l'état interne (compteurs de cycles) de n cycles sautés sans travail
+    virtual void skipCycles(std::uint64_t n) { (void)n; }
+
+    // Réglage d'un paramètre entre deux cycles (surcharges du serveur de simulation) :
+    // mêmes clés et valeurs que le fichier de config, hors TYPE, LABEL et SOURCE.
+    // false si la clé n'est pas réglable ou si la valeur est invalide. Passer par
+    // Platform::setComponentParam(), qui tient compte d'un changement de CLOCK.
+    virtual bool setParam(const std::string& key, const std::string& value) {
+        if (key == "CLOCK") return clock.parse(value);
+        return false;
+    }
+
+    STATS_ONLY(const ComponentStats& getStats() const { return stats; })
+
+    const Clock& getClock() const { return clock; }
+    void setClock(const Clock& c) { clock = c; }
+
+    // Clé CLOCK, commune à tous les fichiers de config
+    bool parseClock(const std::string& value) {
+        if (clock.parse(value)) return true;
+        Log::error() << "Error: invalid CLOCK '" << value << "' (expected P [PHASE] or N/D [PHASE] with N <= D), "
+                     << "parent clock kept";
+        return false;
+    }
 };
 
 // ======================================================================================
@@ -61,10 +118,77 @@ public:
 
     virtual DataValue read() = 0;
 
+    // true si un read() peut renvoyer une donnée valide ; par défaut on suppose que oui
+    // (les lecteurs d'une source inconnue restent alors actifs à chaque cycle)
+    virtual bool hasData() const { return true; }
+
+    // Lecture groupée : jusqu'à max valeurs dans out, arrêt à la première lecture invalide
+    // (comptée comme un read() vide) ; renvoie le nombre de valeurs lues.
+    // Par défaut : read() en boucle
+    virtual std::size_t readBatch(value_t* out, std::size_t max) {
+        std::size_t n = 0;
+        while (n < max) {
+            DataValue v = read();
+            if (!v.valid) break;
+            out[n++] = v.value;
+        }
+        return n;
+    }
+
+    // Composant qui produit réellement les données de read() : lui-même, sauf une
+    // plateforme qui transmet celles de son OUTPUT (cf Platform) ; sert aux analyses de
+    // dépendances (Scheduler, partitions, aotgen)
+    virtual ReadableComponent* producer() { return this; }
+
     void printInfo() const override = 0;
     //PrintInfo reste virtuelle pure et sera à implémenter pour chaque classe dérivée
 };
 
+// ======================================================================================
+//                        SourceHandle
+// Source d'un composant (BUS, MEMORY, DISPLAY), liée avec son type concret quand c'est
+// un CPU, un BUS ou une MEMORY : read() et hasData() appellent alors directement la
+// méthode de la classe, inlinée par le compilateur (définitions dans dispatch.h), au lieu
+// de passer par la vtable. Pour tout autre type (sous-classe comprise), ou si le dispatch
+// typé est désactivé au moment de la liaison, l'appel reste virtuel.
+// S'utilise comme un pointeur : if (source), source->getLabel(), source = ptr;
+// ======================================================================================
+class SourceHandle {
+public:
+    enum class Kind : std::uint8_t { VIRTUAL, CPU, BUS, MEMORY };
+
+private:
+    ReadableComponent* ptr{nullptr};
+    Kind kind{Kind::VIRTUAL};
+
+    static inline bool typedDispatch = true;
+
+public:
+    SourceHandle() = default;
+    SourceHandle(ReadableComponent* c) { *this = c; }
+    SourceHandle& operator=(ReadableComponent* c); // dispatch.cpp
+
+    // Choix global, appliqué aux liaisons faites ensuite (sim --dispatch virtual|typed)
+    static void setTypedDispatch(bool enabled) { typedDispatch = enabled; }
+    static bool isTypedDispatch() { return typedDispatch; }
+
+    // Liaison toujours virtuelle, quel que soit le choix global (benchmarks)
+    static SourceHandle virtualOnly(ReadableComponent* c) {
+        SourceHandle h;
+        h.ptr = c;
+        return h;
+    }
+
+    ReadableComponent* get() const { return ptr; }
+    ReadableComponent* operator->() const { return ptr; }
+    explicit operator bool() const { return ptr != nullptr; }
+    Kind getKind() const { return kind; }
+
+    inline DataValue read() const;   // dispatch.h
+    inline bool hasData() const;     // dispatch.h
+    inline std::size_t readBatch(value_t* out, std::size_t max) const; // dispatch.h
+};
+
 // ======================================================================================
 //                        Registre de ReadableComponent
 // Recense tous les ReadableComponent créés pour permettre leur recherche par label
@@ -72,35 +196,64 @@ public:
 //         via ReadableComponentRegistry::registerComponent(this);
 //         pour retrouver un composant par son label, utiliser
 //         ReadableComponentRegistry::getComponentByLabel(label); (BUS en a besoin)
+// Ces deux fonctions travaillent sur la registry courante du thread : la registry
+// globale, ou celle installée par un ReadableComponentRegistry::Scope. La plateforme
+// racine charge sa hiérarchie dans sa propre registry : plusieurs plateformes aux mêmes
+// labels coexistent dans un processus, et aucune ne laisse de pointeur derrière elle.
 // ======================================================================================
 class ReadableComponentRegistry {
     private:
-        static inline std::vector<ReadableComponent*> registry;
+        std::vector<ReadableComponent*> registry;
+        // Index label -> composant (le premier enregistré l'emporte, comme la recherche
+        // linéaire d'origine). Le label doit être fixé avant l'enregistrement.
+        std::unordered_map<std::string, ReadableComponent*> byLabel;
+
+        static ReadableComponentRegistry& global() {
+            static ReadableComponentRegistry instance;
+            return instance;
+        }
+        static inline thread_local ReadableComponentRegistry* current = nullptr;
 
     public:
-        static void registerComponent(ReadableComponent* comp) {
+        // Registry courante remplacée pendant la portée de l'objet (chargement d'une plateforme)
+        class Scope {
+            ReadableComponentRegistry* previous;
+        public:
+            explicit Scope(ReadableComponentRegistry& r) : previous(current) { current = &r; }
+            ~Scope() { current = previous; }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+        static ReadableComponentRegistry& active() { return current ? *current : global(); }
+
+        void add(ReadableComponent* comp) {
             registry.push_back(comp);
+            byLabel.emplace(comp->getLabel(), comp);
         }
-        static ReadableComponent* getComponentByLabel(const std::string& lbl) {
-            for (auto comp : registry) {
-                if (comp->getLabel() == lbl) {
-                    return comp;
-                }
+        ReadableComponent* find(const std::string& lbl) const {
+            auto it = byLabel.find(lbl);
+            if (it != byLabel.end()) {
+                return it->second;
             }
             return nullptr; // Retourne nullptr si aucun composant trouvé
         }
 
-        static void printAllComponents() {
+        static void registerComponent(ReadableComponent* comp) { active().add(comp); }
+        static ReadableComponent* getComponentByLabel(const std::string& lbl) { return active().find(lbl); }
+
+        void printAllComponents() const {
             std::cout << "Registered ReadableComponents:" << std::endl;
             for (auto comp : registry) {
                 std::cout << " - " << comp->getLabel() << std::endl;
             }
         }
 
-        static bool isEmpty() {
+        bool isEmpty() const {
             return registry.empty();
         }
 
+        const std::vector<ReadableComponent*>& components() const { return registry; }
 };
 
 // ======================================================================================
@@ -108,7 +261,7 @@ class ReadableComponentRegistry {
 // ======================================================================================
 
 // Trim : supprime les espaces en début et fin de chaîne
-static std::string trim(const std::string& s) {
+inline std::string trim(const std::string& s) {
     size_t start = s.find_first_not_of(" \t");
     size_t end = s.find_last_not_of(" \t");
     if (start == std::string::npos) return "";
@@ -0,0 +1,85 @@
+#ifndef LIVESTATS_H
+#define LIVESTATS_H
+
+#include "lib.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+class Platform;
+
+// ======================================================================================
+//                                 LIVESTATS
+// Publication de l'avancement d'une simulation dans un segment de mémoire partagée POSIX
+// (shm_open), relu par l'outil simtop sans interrompre la simulation.
+// - update() est appelée tous les N cycles par la boucle principale : quelques stores
+//   atomiques relaxés encadrés par un seqlock (seq impair = écriture en cours)
+// - un lecteur copie le segment puis relit seq : si seq a changé (ou était impair),
+//   la copie est incohérente et il recommence
+// Les compteurs produced/consumed viennent de stats.h (0 si compilé sans PROJC_STATS),
+// l'occupation des buffers est toujours disponible.
+// ======================================================================================
+
+namespace live {
+
+constexpr char MAGIC[8] = {'P', 'R', 'O', 'J', 'C', 'L', 'I', 'V'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::size_t LABEL_SIZE = 48;
+
+struct Entry {
+    char type[8];
+    char label[LABEL_SIZE];
+    std::atomic<std::uint64_t> produced;
+    std::atomic<std::uint64_t> consumed;
+    std::atomic<std::uint64_t> occupancy;
+};
+
+struct Segment {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t n_entries;
+    std::uint64_t pid;
+    std::atomic<std::uint64_t> seq;
+    std::atomic<std::uint64_t> cycle;
+    std::atomic<std::uint64_t> cyclesPerSecBits; // double, stocké bit à bit
+    std::atomic<std::uint64_t> totalCycles;      // 0 si inconnu
+    Entry entries[1];                            // n_entries entrées en réalité
+
+    static std::size_t bytesFor(std::uint32_t n) {
+        return sizeof(Segment) + (n ? n - 1 : 0) * sizeof(Entry);
+    }
+};
+
+} // namespace live
+
+class LiveStats {
+private:
+    struct Source {
+        enum class Kind { CPU, BUS, MEMORY, DISPLAY } kind;
+        const Component* component;
+    };
+
+    std::string name;
+    std::vector<Source> sources;
+    live::Segment* segment{nullptr};
+    std::size_t segmentSize{0};
+    std::uint64_t interval;
+
+    std::chrono::steady_clock::time_point lastTime;
+    std::uint64_t lastCycle{0};
+
+public:
+    LiveStats(Platform& platform, const std::string& shmName, std::uint64_t interval, std::uint64_t totalCycles = 0);
+    ~LiveStats();
+
+    LiveStats(const LiveStats&) = delete;
+    LiveStats& operator=(const LiveStats&) = delete;
+
+    bool isOpen() const { return segment != nullptr; }
+    const std::string& getName() const { return name; }
+    std::uint64_t getInterval() const { return interval; }
+
+    void update(std::uint64_t cycle);
+};
+
+#endif
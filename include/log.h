@@ -0,0 +1,66 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <functional>
+#include <sstream>
+#include <string>
+
+// ======================================================================================
+//                                 LOG
+// Messages de diagnostic des composants et du chargement (erreurs de config, source
+// introuvable, division par zéro...) : jamais écrits directement sur la console.
+//   Log::error() << "Error: Could not open " << filename;
+// Le message (sans fin de ligne) est remis au sink du thread à la fin de l'instruction.
+// Sink par défaut : INFO sur std::cout, WARNING et ERROR sur std::cerr, une ligne par
+// message (comportement du binaire sim). Un Log::Scope installe un autre sink pour le
+// thread courant le temps de sa portée (cf simulation.h) ; un sink vide ignore tout.
+// ======================================================================================
+
+enum class LogLevel { INFO, WARNING, ERROR };
+
+class Log {
+public:
+    using Sink = std::function<void(LogLevel level, const std::string& message)>;
+
+    // Message en cours de construction, remis au sink à la destruction
+    class Line {
+    public:
+        explicit Line(LogLevel lvl) : level(lvl) {}
+        Line(const Line&) = delete;
+        Line& operator=(const Line&) = delete;
+        ~Line() { Log::write(level, stream.str()); }
+
+        template <typename T>
+        Line& operator<<(const T& value) {
+            stream << value;
+            return *this;
+        }
+
+    private:
+        LogLevel level;
+        std::ostringstream stream;
+    };
+
+    // Sink du thread courant remplacé pendant la portée de l'objet
+    class Scope {
+    public:
+        explicit Scope(const Sink* sink) : previous(current) { current = sink; }
+        ~Scope() { current = previous; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const Sink* previous;
+    };
+
+    static Line info() { return Line(LogLevel::INFO); }
+    static Line warning() { return Line(LogLevel::WARNING); }
+    static Line error() { return Line(LogLevel::ERROR); }
+
+    static void write(LogLevel level, const std::string& message);
+
+private:
+    static thread_local const Sink* current; // nullptr : sink par défaut (console)
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define MEM_H__
 
 #include "lib.h"
+#include "arena.h"
 
 // ======================================================================================
 //                           MEMORY
@@ -16,30 +17,77 @@ class Memory : public ReadableComponent {
 private:
     std::size_t capacity{1};
     int accessTime{1};
-    int cycleCounter{0};
-    ReadableComponent* source{nullptr};
+    std::uint64_t cycleCounter{0}; // 64 bits : ne déborde pas sur une longue simulation
+    SourceHandle source;
     std::string sourceLabelStored;
 
-    std::vector<DataValue> buffer;
+    std::vector<DataValue> storage;  // stockage tant que la mémoire n'est pas dans une arena
+    DataValue* buffer{nullptr};      // capacity cases (storage ou arena)
     std::size_t head{0};
     std::size_t tail{0};
     std::size_t count{0};
 
-    void pushValue(const DataValue& dv);
-
 public:
     Memory(const std::string& lbl = "MEMORY");
+    Memory(const Memory& other); // buffer recopié sur le tas
+    Memory& operator=(const Memory&) = delete;
     virtual ~Memory();
 
+    void pushValue(const DataValue& dv); // écriture directe dans le buffer circulaire
+
+    // Buffer circulaire dans l'arena de la plateforme (un setSize() ultérieur le ramène sur le tas)
+    void placeIn(Arena& arena);
+
     void setSize(std::size_t s);
     void setAccessTime(int a);
     void bindSource(const std::string& lbl);
+    void bindSource(ReadableComponent* src);
+    ReadableComponent* getSource();
     std::string getSourceLabel() const;
 
+    std::size_t getSize() const { return capacity; }
+    int getAccessTime() const { return accessTime; }
+    std::size_t getCount() const { return count; }
+
     bool loadFromFile(const std::string& filename) override;
+    bool setParam(const std::string& key, const std::string& value) override;
 
     void simulate() override;
-    DataValue read() override;
+    void simulate(std::uint64_t cycles) override;
+    // Sans temps d'accès : la source est vidée une fois s'il y a au moins un créneau
+    void fastForward(std::uint64_t cycles) override;
+
+    // Dans le header pour être inlinée par SourceHandle (dispatch.h)
+    DataValue read() override {
+        if (count == 0) {
+            STATS_ONLY(++stats.emptyReads;)
+            return DataValue(0.0, false);
+        }
+        DataValue dv = buffer[head];
+        head = (head + 1) % capacity;
+        count--;
+        STATS_ONLY(++stats.produced;)
+        return dv;
+    }
+
+    // Copie directe du buffer circulaire, en deux segments au plus
+    std::size_t readBatch(value_t* out, std::size_t max) override {
+        std::size_t n = count < max ? count : max;
+        std::size_t first = capacity - head < n ? capacity - head : n;
+        for (std::size_t i = 0; i < first; ++i) out[i] = buffer[head + i].value;
+        for (std::size_t i = first; i < n; ++i) out[i] = buffer[i - first].value;
+        head = (head + n) % capacity;
+        count -= n;
+        STATS_ONLY(
+            stats.produced += n;
+            if (n < max) ++stats.emptyReads;
+        )
+        return n;
+    }
+
+    bool hasData() const override { return count > 0; }
+    std::uint64_t nextWakeup(std::uint64_t now) const override;
+    void skipCycles(std::uint64_t n) override { cycleCounter += n; }
     void printInfo() const override;
     void showMemoryContent();
 };
@@ -0,0 +1,82 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include "lib.h"
+#include "clock.h"
+#include <cstdint>
+#include <ostream>
+
+class Platform;
+class BUS;
+
+// ======================================================================================
+//                                 PARTITION
+// Simulation d'une plateforme répartie sur plusieurs processus d'une même machine :
+// - unités de découpage : les composants directs de la racine, et chaque sous-plateforme
+//   directe avec toute sa hiérarchie
+// - seul un BUS peut être coupé (sa source dans une autre partition) : un composant d'un
+//   autre type garde sa source dans sa partition (unités fusionnées) ; les groupes sont
+//   ensuite répartis entre les partitions par nombre de composants
+// - un BUS coupé devient un canal SPSC en mémoire partagée : le processus de la source
+//   fait la lecture (BUS::fetch) à la place du BUS dans l'ordre de simulate(), le
+//   processus du BUS reçoit ces valeurs au cycle suivant (BUS::deliver)
+// - synchronisation conservative : la latence d'un BUS (1 cycle) est le lookahead.
+//   Chaque producteur publie sur ses canaux le nombre de cycles terminés ; le cycle c
+//   d'un consommateur n'attend que la fin du cycle c - 1 de ses producteurs. Une
+//   partition peut donc prendre de l'avance, dans la limite de la capacité des anneaux
+//   (au moins 2 cycles de données : pas d'interblocage). Avec un domaine d'horloge
+//   (clock.h), un BUS coupé reçoit au front suivant ce que sa source a lu au précédent
+// Chaque partition est un fork() du processus chargé : un seul chargement de la
+// configuration, la mémoire est partagée en copy-on-write jusqu'au premier cycle.
+// Les sorties (DISPLAY, état final) de chaque partition sont regroupées par partition
+// en fin de run(), dans le flux choisi par l'appelant. Les ordres de lecture étant ceux d'une simulation en un seul
+// processus, les valeurs affichées sont identiques.
+// ======================================================================================
+
+class PartitionedRun {
+public:
+    PartitionedRun(Platform& platform, unsigned partitions);
+    ~PartitionedRun();
+    PartitionedRun(const PartitionedRun&) = delete;
+    PartitionedRun& operator=(const PartitionedRun&) = delete;
+
+    // Simule cycles cycles dans un processus par partition et recopie leurs sorties dans
+    // os (std::cout de chaque processus, redirigé vers un fichier temporaire) ; false si
+    // une partition a échoué (les autres sont alors arrêtées)
+    bool run(std::uint64_t cycles, std::ostream& os);
+
+    unsigned getPartitions() const { return partitions; }
+    std::size_t getCutLinks() const { return channels.size(); }
+    void printPlan(std::ostream& os) const;
+
+private:
+    // Action d'une partition à sa place dans l'ordre de Platform::simulate()
+    struct Step {
+        enum class Kind { SIMULATE, FETCH, DELIVER } kind;
+        Component* component;
+        BUS* bus;
+        std::uint32_t channel;
+        ClockChain clock; // horloge effective : l'action n'a lieu qu'aux fronts
+    };
+
+    struct ChannelInfo {
+        BUS* bus;
+        unsigned producer;   // partition de la source
+        unsigned consumer;   // partition du BUS
+        std::size_t offset;  // dans le segment partagé
+        std::size_t capacity;
+    };
+
+    unsigned partitions{1};
+    std::vector<std::vector<Step>> steps;         // par partition
+    std::vector<std::size_t> componentsOf;        // par partition
+    std::vector<ChannelInfo> channels;
+    std::vector<std::vector<std::uint32_t>> outbound; // canaux produits, par partition
+
+    void* segment{nullptr};
+    std::size_t segmentSize{0};
+
+    void runPartition(unsigned k, std::uint64_t cycles);
+};
+
+#endif
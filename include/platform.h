@@ -6,19 +6,81 @@
 #include "bus.h"
 #include "mem.h"
 #include "display.h"
+#include "coroutine.h"
+#include "profiler.h"
+#include "arena.h"
+
+class Scheduler;
 
 // ======================================================================================
 //                                 PLATFORM
+// Config : TYPE, LABEL, CLOCK, COMPONENT (un par composant, sous-plateformes comprises)
+// et OUTPUT: <label>, port de sortie facultatif : un composant direct de la plateforme
+// (CPU, MEMORY, BUS, DMA ou sous-plateforme) dont read() transmet les données. Une
+// plateforme avec OUTPUT est enregistrée sous son LABEL et peut servir de SOURCE, comme
+// une boîte noire, sans BUS intermédiaire (ni son cycle de latence).
 // ======================================================================================
 
 class Platform : public ReadableComponent {
 private:
-    std::vector<std::unique_ptr<CPU>> cpus;
-    std::vector<std::unique_ptr<Memory>> memories;
-    std::vector<std::unique_ptr<BUS>> buses;
-    std::vector<std::unique_ptr<Display>> displays;
-    std::vector<std::unique_ptr<Platform>> platforms;
-    ReadableComponentRegistry registry;
+    // Tous les composants de la hiérarchie sont alloués dans l'arena de la plateforme
+    // racine (ownArena), dans l'ordre de chargement ; les sous-plateformes la partagent.
+    // Déclarée en premier : détruite en dernier, elle détruit les composants.
+    Arena ownArena;
+    Arena* arena{&ownArena};
+
+    std::vector<CPU*> cpus;
+    std::vector<Memory*> memories;
+    std::vector<BUS*> buses;
+    std::vector<CoroutineComponent*> coroutines; // composants écrits en coroutine (DMA, ...)
+    std::vector<Display*> displays;
+    std::vector<Platform*> platforms;
+    ReadableComponentRegistry registry; // racine : labels de toute la hiérarchie
+
+    SourceHandle output; // OUTPUT, vide si la plateforme ne produit rien
+
+    // Fichier de config de chaque composant direct chargé par loadFromFile (HotReload)
+    std::vector<std::pair<std::string, Component*>> componentFiles;
+
+    // Composant direct de ce label (port OUTPUT), nullptr si aucun
+    ReadableComponent* findChild(const std::string& lbl) const;
+
+    // Fin de chargement (racine seulement) : l'état modifié à chaque cycle (registres,
+    // files des BUS, buffers des MEMORY) est recopié d'un bloc dans l'arena, contigu et
+    // dans l'ordre de simulate() ; labels et config restent dans les objets, les
+    // programmes dans le cache partagé (cf Program)
+    void compactState();
+
+    // Chargement depuis un fichier de config (loadFromFile une fois l'image écartée)
+    bool loadConfig(const std::string& filename);
+
+    // Fin de chargement (racine seulement) : liaison des sources nommées avant d'être chargées
+    void resolveSources();
+
+    // Profiling optionnel : une entrée du profiler par composant, dans l'ordre de simulate()
+    Profiler* profiler{nullptr};
+    std::vector<std::size_t> profileSlots;
+
+    void simulateProfiled();
+
+    // Domaines d'horloge (clock.h) : tick compte les cycles de cette plateforme ; si un
+    // composant direct a sa propre horloge (clocked), chacun reçoit simulate() à ses fronts
+    std::uint64_t tick{0};
+    bool clocked{false};
+
+    void updateClocked();
+    void simulateClocked();
+    // Fronts de c pendant les n prochains cycles de la plateforme
+    std::uint64_t edges(const Component& c, std::uint64_t n) const {
+        return c.getClock().ticks(tick + n) - c.getClock().ticks(tick);
+    }
+
+    // Simulation événementielle (scheduler.h), construite au premier run()
+    bool idleSkipping{false};
+    std::unique_ptr<Scheduler> scheduler;
+
+    // Quantum stepping : run() avance chaque composant de quantum cycles par appel
+    std::uint64_t quantum{1};
 
 public:
     Platform(const std::string& lbl = "PLATFORM");
@@ -27,9 +89,123 @@ public:
     ReadableComponentRegistry& getRegistry();
 
     bool loadFromFile(const std::string& filename) override;
+
+    // Image binaire de la plateforme (cf image.h), implémentées dans image.cpp
+    bool saveImage(const std::string& filename);
+    bool loadImage(const std::string& filename);
+    static bool isImageFile(const std::string& filename);
+    // Même format en mémoire (clonage d'une plateforme déjà chargée, cf server.h) ;
+    // name ne sert qu'aux messages d'erreur
+    bool encodeImage(std::string& out);
+    bool decodeImage(const char* data, std::size_t size, const std::string& name);
     void printInfo() const override;
+    // Port de sortie : transmis tels quels au composant OUTPUT (aucune copie)
     DataValue read() override;
+    bool hasData() const override;
+    std::size_t readBatch(value_t* out, std::size_t max) override;
+    ReadableComponent* producer() override { return output ? output->producer() : this; }
+    ReadableComponent* getOutput() const { return output.get(); }
+    void bindOutput(ReadableComponent* port) { output = port; }
+
     void simulate() override;
+    void simulate(std::uint64_t cycles) override;
+    // Fast-forward fonctionnel de toute la hiérarchie (cf sampling.h), chaque domaine
+    // d'horloge avançant de ses fronts ; incompatible avec l'idle skipping (Scheduler)
+    void fastForward(std::uint64_t cycles) override;
+
+    // Simule n cycles : simulate() n fois, ou via le Scheduler si l'idle skipping est actif
+    // (les composants au repos ne sont pas simulés, l'horloge saute les cycles sans activité),
+    // ou par tranches de simulate(quantum) si un quantum > 1 est choisi (précision au cycle
+    // perdue aux frontières : un composant ne voit les données de sa source qu'au quantum suivant)
+    void run(std::uint64_t cycles);
+    void setIdleSkipping(bool enabled);
+    bool isIdleSkipping() const { return idleSkipping; }
+    void setQuantum(std::uint64_t q) { quantum = q ? q : 1; }
+    std::uint64_t getQuantum() const { return quantum; }
+
+    // Active (ou désactive avec nullptr) la mesure de chaque simulate() pour toute la hiérarchie
+    void setProfiler(Profiler* p, const std::string& parentPath = "");
+
+    // Parcours récursif de la hiérarchie, dans l'ordre de simulate() ; f est appelée
+    // avec le type concret de chaque composant (CPU&, Memory&, BUS&,
+    // CoroutineComponent&, Display&, Platform&)
+    template <typename F>
+    void forEachComponent(F&& f) {
+        for (auto& cpu : cpus) f(*cpu);
+        for (auto& mem : memories) f(*mem);
+        for (auto& bus : buses) f(*bus);
+        for (auto& co : coroutines) f(*co);
+        for (auto& display : displays) f(*display);
+        for (auto& platform : platforms) {
+            f(*platform);
+            platform->forEachComponent(f);
+        }
+    }
+
+    // Idem, avec en plus le chemin de la plateforme contenant le composant
+    // (labels des plateformes englobantes séparés par '/', racine comprise)
+    template <typename F>
+    void forEachComponentPath(F&& f, const std::string& parentPath = "") {
+        std::string path = parentPath.empty() ? getLabel() : parentPath + "/" + getLabel();
+        for (auto& cpu : cpus) f(*cpu, path);
+        for (auto& mem : memories) f(*mem, path);
+        for (auto& bus : buses) f(*bus, path);
+        for (auto& co : coroutines) f(*co, path);
+        for (auto& display : displays) f(*display, path);
+        for (auto& platform : platforms) {
+            f(*platform, path);
+            platform->forEachComponentPath(f, path);
+        }
+    }
+
+    // Idem, avec en plus l'horloge effective du composant vue de l'horloge de base
+    // (CLOCK des sous-plateformes englobantes puis le sien, cf clock.h)
+    template <typename F>
+    void forEachComponentClock(F&& f, const ClockChain& parentChain = ClockChain()) {
+        auto chainOf = [&](const Component& c) {
+            ClockChain chain = parentChain;
+            chain.push(c.getClock());
+            return chain;
+        };
+        for (auto& cpu : cpus) f(*cpu, chainOf(*cpu));
+        for (auto& mem : memories) f(*mem, chainOf(*mem));
+        for (auto& bus : buses) f(*bus, chainOf(*bus));
+        for (auto& co : coroutines) f(*co, chainOf(*co));
+        for (auto& display : displays) f(*display, chainOf(*display));
+        for (auto& platform : platforms) {
+            ClockChain chain = chainOf(*platform);
+            f(*platform, chain);
+            platform->forEachComponentClock(f, chain);
+        }
+    }
+
+    std::size_t componentCount();
+
+    // Réglage (Component::setParam) du composant de ce label, cherché dans la registry
+    // de la racine ; false (message dans le log) si le label est inconnu ou le réglage
+    // refusé. Un changement de CLOCK est refusé pendant un run en idle skipping.
+    bool setComponentParam(const std::string& label, const std::string& key, const std::string& value);
+    // Idem pour un composant de la hiérarchie donné directement (DISPLAY compris, sans
+    // label) ; name ne sert qu'aux messages. Appelé entre deux run(), le composant
+    // garde ses données en cours (registres, files, buffer de la MEMORY)
+    bool applyParam(Component& c, const std::string& name, const std::string& key, const std::string& value);
+
+    // Composants directs et le fichier de config d'où chacun a été chargé (vide pour une
+    // plateforme chargée depuis une image)
+    const std::vector<std::pair<std::string, Component*>>& getComponentFiles() const { return componentFiles; }
+
+    // Sortie de tous les DISPLAY de la hiérarchie (cf Display::setOutput)
+    void setDisplayOutput(const Display::Output& output);
+
+    // Sous-plateformes directes (unités de découpage du mode multi-processus, partition.h)
+    const std::vector<Platform*>& getSubplatforms() const { return platforms; }
+
+    // Octets occupés dans l'arena (composants + état chaud)
+    std::size_t arenaBytes() const { return arena->bytesUsed(); }
+
+    // Rapport des compteurs de performance (stats.cpp), format "json" ou "csv"
+    // Renvoie false si le simulateur a été compilé sans PROJC_STATS
+    bool writeStats(std::ostream& os, const std::string& format);
 };
 
 #endif
@@ -0,0 +1,76 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "lib.h"
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROJC_HAS_TSC 1
+#endif
+
+// ======================================================================================
+//                                 PROFILER
+// Mesure du coût de chaque appel à simulate(), activé par Platform::setProfiler()
+// (sinon Platform::simulate() garde sa boucle sans aucune mesure)
+// Méthodes pertinentes :
+//   - addEntry() : une entrée par composant, créée au moment de l'attachement
+//   - time() : chronomètre un simulate() et l'impute à une entrée
+//   - writeTop() : tableau des N composants les plus coûteux + agrégat par type
+//   - writeFolded() : "folded stacks" (plateforme;sous-plateforme;composant ns)
+//                     directement utilisables par flamegraph.pl / speedscope
+// Horloge : steady_clock (ns) par défaut, ou TSC (rdtsc) calibré en fin de run
+// ======================================================================================
+
+class Profiler {
+public:
+    enum class ClockSource { STEADY, TSC };
+
+    struct Entry {
+        std::string path;  // plateformes englobantes séparées par '/'
+        std::string type;
+        std::string label;
+        std::uint64_t calls{0};
+        std::uint64_t ticks{0};
+    };
+
+private:
+    ClockSource clockSource;
+    std::vector<Entry> entries;
+
+    // Calibration TSC : ticks et ns écoulés depuis la création du profiler
+    std::uint64_t startTicks;
+    std::chrono::steady_clock::time_point startTime;
+
+    std::uint64_t now() const {
+#ifdef PROJC_HAS_TSC
+        if (clockSource == ClockSource::TSC) return __rdtsc();
+#endif
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    double nsPerTick() const;
+
+public:
+    explicit Profiler(ClockSource source = ClockSource::STEADY);
+
+    std::size_t addEntry(const std::string& path, const std::string& type, const std::string& label);
+
+    template <typename C>
+    void time(std::size_t slot, C& component) {
+        std::uint64_t t0 = now();
+        component.simulate();
+        std::uint64_t t1 = now();
+        Entry& e = entries[slot];
+        e.ticks += t1 - t0;
+        ++e.calls;
+    }
+
+    const std::vector<Entry>& getEntries() const { return entries; }
+
+    void writeTop(std::ostream& os, std::size_t n) const;
+    void writeFolded(std::ostream& os) const;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef RELOAD_H
+#define RELOAD_H
+
+#include "lib.h"
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+class Platform;
+struct ConfigFile;
+
+// ======================================================================================
+//                                 HOT RELOAD
+// Rechargement à chaud des configs des composants (sim --watch) : les fichiers chargés
+// par Platform::loadFromFile sont surveillés par inotify (répertoires, pour suivre les
+// éditeurs qui remplacent le fichier), et request() demande de tous les relire (SIGHUP).
+// poll() est appelée par la boucle principale entre deux cycles : chaque clé modifiée
+// est appliquée par Platform::applyParam (WIDTH, SIZE, ACCESS, REFRESH, FREQUENCY,
+// CORES, BURST, LATENCY, FORMAT, PRECISION, CLOCK...), sans perdre les données en cours.
+// Les changements de structure (TYPE, LABEL, SOURCE, PROGRAM, COMPONENT, OUTPUT) ne
+// s'appliquent qu'au redémarrage : ils sont signalés et ignorés.
+// ======================================================================================
+
+class HotReload {
+private:
+    struct Watched {
+        std::string path;
+        Component* component;
+        std::shared_ptr<const ConfigFile> applied; // dernière config appliquée
+    };
+
+    Platform& platform;
+    std::vector<Watched> files;
+    int fd{-1};                                   // inotify, -1 si indisponible
+    std::unordered_map<int, std::string> dirOf;   // watch -> répertoire surveillé
+
+    static inline std::atomic<bool> requested{false};
+
+    std::size_t apply(Watched& w, const std::shared_ptr<const ConfigFile>& cfg);
+
+public:
+    explicit HotReload(Platform& platform);
+    ~HotReload();
+    HotReload(const HotReload&) = delete;
+    HotReload& operator=(const HotReload&) = delete;
+
+    // false si inotify n'est pas disponible (request() reste utilisable)
+    bool isWatching() const { return fd >= 0; }
+    std::size_t fileCount() const { return files.size(); }
+
+    // Relecture de tous les fichiers au prochain poll() ; utilisable depuis un gestionnaire de signal
+    static void request() { requested.store(true); }
+
+    // Applique les changements détectés depuis le dernier appel ; nombre de paramètres modifiés
+    std::size_t poll();
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+#include "lib.h"
+#include <cstdint>
+#include <ostream>
+
+class Platform;
+
+// ======================================================================================
+//                                 SAMPLING
+// Simulation échantillonnée (sim --sample PERIOD:WINDOW[:WARMUP]) : chaque période de
+// PERIOD cycles se compose de
+//   - PERIOD - WARMUP - WINDOW cycles de fast-forward fonctionnel (Component::fastForward :
+//     les données circulent sans latence, sans affichage ni relevé par cycle)
+//   - WARMUP cycles détaillés non mesurés, pour remettre les buffers en régime
+//   - WINDOW cycles détaillés mesurés (Platform::run, affichages DISPLAY compris)
+// Les compteurs (stats.h) de chaque fenêtre donnent un débit par cycle et par composant ;
+// leur moyenne sur les fenêtres est extrapolée au nombre total de cycles, avec un
+// intervalle de confiance à 95 % (loi de Student, écart-type entre fenêtres).
+// Une dernière période incomplète est entièrement en fast-forward.
+// Sans PROJC_STATS, seuls les cycles avancent : aucune estimation n'est produite.
+// ======================================================================================
+
+class SampledRun {
+public:
+    enum Metric { PRODUCED, CONSUMED, STALL_CYCLES, DROPPED, EMPTY_READS, AVG_OCCUPANCY, METRICS };
+
+    // Estimation d'un compteur par cycle : moyenne des fenêtres et demi-largeur de
+    // l'intervalle de confiance (NaN avec moins de deux fenêtres)
+    struct Estimate {
+        std::uint64_t windows{0};
+        double perCycle{0.0};
+        double halfWidth{0.0};
+    };
+
+    SampledRun(Platform& platform, std::uint64_t period, std::uint64_t window, std::uint64_t warmup = 0);
+
+    // Analyse "PERIOD:WINDOW[:WARMUP]" ; false si la valeur est invalide
+    // (WINDOW > 0 et WINDOW + WARMUP <= PERIOD)
+    static bool parse(const std::string& spec, std::uint64_t& period, std::uint64_t& window, std::uint64_t& warmup);
+
+    void run(std::uint64_t cycles);
+
+    std::uint64_t getWindows() const { return windows; }
+    std::uint64_t getCycles() const { return cycles; }
+    std::uint64_t getDetailedCycles() const { return detailed; }
+
+    // Estimation pour le composant de ce label (label "DISPLAY <- source" pour un DISPLAY)
+    Estimate estimate(const std::string& label, Metric metric) const;
+
+    // Rapport des estimations : format "text", "json" ou "csv"
+    void writeReport(std::ostream& os, const std::string& format) const;
+
+private:
+    // Moyenne et variance en une passe (Welford)
+    struct Accumulator {
+        std::uint64_t n{0};
+        double mean{0.0};
+        double m2{0.0};
+        void add(double x) {
+            ++n;
+            double d = x - mean;
+            mean += d / static_cast<double>(n);
+            m2 += d * (x - mean);
+        }
+    };
+
+    struct Entry {
+        std::string path;
+        std::string type;
+        std::string label;
+        const Component* component;
+        STATS_ONLY(ComponentStats start;) // compteurs au début de la fenêtre en cours
+        Accumulator metrics[METRICS];
+    };
+
+    Platform& platform;
+    std::uint64_t period;
+    std::uint64_t window;
+    std::uint64_t warmup;
+    std::vector<Entry> entries;
+
+    std::uint64_t windows{0};
+    std::uint64_t cycles{0};
+    std::uint64_t detailed{0};
+
+    void beginWindow();
+    void endWindow();
+    Estimate estimateOf(const Entry& e, Metric metric) const;
+};
+
+#endif
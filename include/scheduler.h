@@ -0,0 +1,75 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "lib.h"
+#include <cstdint>
+#include <queue>
+
+class Platform;
+
+// ======================================================================================
+//                                 SCHEDULER
+// Simulation événementielle d'une plateforme (idle skipping) :
+// - la hiérarchie est aplatie dans l'ordre de Platform::simulate()
+// - après chaque simulate(), le composant donne son prochain réveil (nextWakeup) ;
+//   les composants endormis (NEVER) sont réveillés par leur source quand celle-ci a
+//   de nouvelles données (même cycle si le lecteur vient après la source dans l'ordre
+//   de simulation, cycle suivant sinon, comme dans la boucle cycle par cycle)
+// - les réveils sont rangés dans une roue temporelle (WHEEL_SIZE cycles) plus un tas
+//   pour les réveils lointains ; quand plus rien n'est prévu avant un cycle donné,
+//   l'horloge globale saute directement jusqu'à lui
+// - un composant sauté pendant n cycles reçoit skipCycles(n) avant son prochain
+//   simulate() (et en fin de run()), pour garder ses compteurs internes exacts
+// - domaines d'horloge (clock.h) : un composant n'est simulé qu'aux cycles de base où
+//   son horloge effective a un front ; nextWakeup() et skipCycles() comptent ses
+//   propres cycles, convertis ici en cycles de base
+// Les compteurs d'occupation (stats.h) ne sont relevés qu'aux cycles simulés.
+// ======================================================================================
+
+class Scheduler {
+private:
+    static constexpr std::size_t WHEEL_SIZE = 1024; // puissance de 2
+    static constexpr std::size_t WHEEL_MASK = WHEEL_SIZE - 1;
+
+    std::vector<Component*> components;
+    std::vector<ReadableComponent*> readable;       // nullptr pour les non-lisibles
+    std::vector<std::vector<std::uint32_t>> consumers;
+    std::vector<bool> polled;  // source hors de la plateforme : simulé à chaque cycle
+
+    std::vector<ClockChain> clocks;   // horloge effective de chaque composant
+    std::vector<bool> based;          // horloge de base : pas de conversion
+
+    std::vector<std::uint64_t> wake;  // cycle de base du prochain simulate() prévu, NEVER si endormi
+    std::vector<std::uint64_t> done;  // cycles propres traités (simulés ou rattrapés)
+
+    std::vector<std::vector<std::uint32_t>> wheel;
+    using Far = std::pair<std::uint64_t, std::uint32_t>;
+    std::priority_queue<Far, std::vector<Far>, std::greater<Far>> far;
+
+    std::vector<std::uint64_t> active;  // bitset des composants à simuler au cycle courant
+    std::uint64_t cycle{0};             // prochain cycle à simuler
+
+    void schedule(std::uint32_t i, std::uint64_t at);
+    void wakeConsumers(std::uint32_t i);
+    std::uint64_t nextEvent();
+    void catchUp(std::uint32_t i, std::uint64_t upTo);
+
+    // Cycles propres de i pendant les m premiers cycles de base, et cycle de base de son
+    // cycle propre k (NEVER reste NEVER)
+    std::uint64_t ticksOf(std::uint32_t i, std::uint64_t m) const { return based[i] ? m : clocks[i].ticks(m); }
+    std::uint64_t cycleOf(std::uint32_t i, std::uint64_t k) const { return based[i] ? k : clocks[i].cycleOfTick(k); }
+
+public:
+    explicit Scheduler(Platform& platform);
+
+    void run(std::uint64_t cycles);
+
+    // Paramètre de c modifié entre deux run() : c est simulé à son prochain front, qui
+    // redonne son nouveau réveil (un réveil prévu avec l'ancien réglage peut être trop tard)
+    void reschedule(const Component* c);
+
+    std::uint64_t getCycle() const { return cycle; }
+    std::size_t size() const { return components.size(); }
+};
+
+#endif
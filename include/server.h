@@ -0,0 +1,119 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "threadpool.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ======================================================================================
+//                                 SERVER
+// Serveur de simulation persistant sur une socket Unix locale (outil simserver) :
+// chaque plateforme est chargée une seule fois puis gardée en mémoire sous forme
+// d'image (Platform::encodeImage : hiérarchie, liens et programmes déjà décodés) ; un
+// job la clone (Simulation::loadImage), applique ses réglages et la simule sur un des
+// workers, en renvoyant les résultats au fil de l'eau.
+// Chaque connexion a son propre thread, qui lit les requêtes et attend la fin de ses
+// jobs : seuls les RUN occupent un worker, un client inactif ne bloque pas le pool.
+//
+// Protocole texte, une requête ou une réponse par ligne, champs séparés par des
+// tabulations (les labels peuvent contenir des espaces) :
+//   RUN  <platform> <cycles> [<label> <KEY> <value>]...
+//        platform : identifiant donné à addPlatform() ou chemin d'une config (chargée
+//        et mise en cache à la première demande) ; réglages cf Component::setParam
+//     -> OUTPUT <source> <valeurs séparées par des espaces>    à chaque rafraîchissement
+//        LOG <INFO|WARNING|ERROR> <message>
+//        STATS <label> <produced> <consumed> <empty_reads> <dropped> <stall_cycles>
+//        DONE <cycles> <microsecondes>            ou      ERROR <message>
+//        (simulé par tranches de JOB_CHUNK cycles, interrompu par SHUTDOWN)
+//   LIST     -> PLATFORM <id> <fichier> ... puis DONE
+//   PING     -> PONG
+//   SHUTDOWN -> DONE, puis arrêt du serveur (jobs en cours arrêtés à la fin de leur
+//               tranche, réponse ERROR)
+// Une connexion peut enchaîner plusieurs requêtes, traitées dans l'ordre ; les jobs de
+// connexions différentes tournent en parallèle, au plus un par worker.
+// ======================================================================================
+
+class SimServer {
+public:
+    SimServer(const std::string& socketPath, unsigned workers);
+    ~SimServer();
+    SimServer(const SimServer&) = delete;
+    SimServer& operator=(const SimServer&) = delete;
+
+    bool isOpen() const { return listenFd >= 0; }
+    const std::string& getPath() const { return path; }
+
+    // Précharge une plateforme sous un identifiant ; false si elle ne se charge pas
+    bool addPlatform(const std::string& id, const std::string& filename);
+
+    // Accepte les connexions jusqu'à stop() ou une requête SHUTDOWN
+    void serve();
+    // Utilisable depuis un gestionnaire de signal
+    void stop() { stopping.store(true); }
+
+    // Cycles simulés entre deux vérifications de l'arrêt du serveur
+    static constexpr std::uint64_t JOB_CHUNK = 65536;
+
+private:
+    struct CachedPlatform {
+        std::string filename;
+        std::string image;
+        std::string error; // chargement échoué
+    };
+
+    std::string path;
+    int listenFd{-1};
+    std::atomic<bool> stopping{false};
+
+    std::mutex cacheMtx;
+    std::mutex loadMtx; // un seul chargement à la fois, les jobs en cache continuent
+    std::unordered_map<std::string, std::shared_ptr<const CachedPlatform>> cache;
+    std::vector<std::string> order; // ids dans l'ordre de chargement (LIST)
+
+    // Threads de connexion (détachés) encore actifs, attendus par serve()
+    std::mutex connectionsMtx;
+    std::condition_variable connectionsDone;
+    std::size_t connections{0};
+
+    // Déclaré en dernier : détruit (jobs terminés) avant le cache
+    ThreadPool pool;
+
+    std::shared_ptr<const CachedPlatform> load(const std::string& filename);
+
+    std::shared_ptr<const CachedPlatform> platformFor(const std::string& id);
+    void handle(int fd);
+    void runJob(int fd, const std::vector<std::string>& fields);
+    bool readLine(int fd, std::string& buffer, std::string& line);
+};
+
+// Client minimal du protocole (outil simclient, tests)
+class SimClient {
+public:
+    SimClient() = default;
+    ~SimClient();
+    SimClient(const SimClient&) = delete;
+    SimClient& operator=(const SimClient&) = delete;
+
+    bool connect(const std::string& socketPath);
+    bool isConnected() const { return fd >= 0; }
+
+    // Envoie une requête (champs joints par des tabulations)
+    bool send(const std::vector<std::string>& fields);
+    // Ligne de réponse suivante, sans le '\n' ; false si la connexion est fermée
+    bool readLine(std::string& line);
+
+private:
+    int fd{-1};
+    std::string buffer;
+};
+
+// Découpe une ligne du protocole en champs
+std::vector<std::string> splitFields(const std::string& line);
+
+#endif
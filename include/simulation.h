@@ -0,0 +1,78 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "lib.h"
+#include "display.h"
+#include <memory>
+
+class Platform;
+
+// ======================================================================================
+//                                 SIMULATION
+// Point d'entrée de la bibliothèque libprojsim (make lib) : une plateforme pilotée pas à
+// pas depuis un autre programme, sans jamais écrire sur la console.
+//     Simulation sim;
+//     sim.onOutput([](const Display& d, const value_t* v, std::size_t n) { ... });
+//     if (!sim.load("data/platform.txt")) ...
+//     sim.step(1000);
+//     DataValue v = sim.read("My bus 1");
+// - les sorties DISPLAY passent par la callback de onOutput() (ignorées sans callback)
+// - les messages de diagnostic (chargement, source introuvable, division par zéro...)
+//   passent par la callback de onLog() (ignorés sans callback), cf log.h
+// - chaque Simulation a sa propre registry de labels : plusieurs simulations d'une même
+//   plateforme coexistent dans le processus, une par thread au plus à la fois
+// Les configs parsées restent en cache (ConfigCache) d'une simulation à l'autre.
+// ======================================================================================
+
+class Simulation {
+public:
+    using OutputCallback = Display::Output;
+    using LogCallback = Log::Sink;
+
+    Simulation();
+    ~Simulation();
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Charge une configuration ou une image de plateforme (remplace la précédente) ;
+    // false en cas d'échec, détail via onLog()
+    bool load(const std::string& filename);
+    // Idem depuis une image en mémoire (Platform::encodeImage) : clone d'une plateforme
+    // déjà chargée, sans relire ni reparser sa configuration
+    bool loadImage(const std::string& image, const std::string& name);
+    bool isLoaded() const { return platform != nullptr; }
+
+    // Réglage d'un paramètre d'un composant (Platform::setComponentParam)
+    bool setParam(const std::string& label, const std::string& key, const std::string& value);
+
+    // Avance de n cycles (Platform::run : idle skipping et quantum selon getPlatform())
+    void step(std::uint64_t cycles = 1);
+    std::uint64_t getCycle() const { return cycle; }
+
+    // Donnée suivante du composant de ce label (CPU, BUS, MEMORY, DMA) ;
+    // invalide si le label est inconnu ou si le composant n'a rien à fournir
+    DataValue read(const std::string& label);
+    bool hasData(const std::string& label) const;
+    std::vector<std::string> getLabels() const;
+
+    // Compteurs de performance du composant ; false si le label est inconnu ou si la
+    // bibliothèque est compilée sans PROJC_STATS
+    bool getStats(const std::string& label, ComponentStats& out) const;
+
+    void onOutput(OutputCallback callback) { output = std::move(callback); }
+    void onLog(LogCallback callback) { log = std::move(callback); }
+
+    // Plateforme chargée, pour les réglages avancés (setQuantum, setIdleSkipping...)
+    Platform& getPlatform() { return *platform; }
+
+private:
+    std::unique_ptr<Platform> platform;
+    OutputCallback output;
+    LogCallback log;
+    std::uint64_t cycle{0};
+
+    ReadableComponent* find(const std::string& label) const;
+    void adopt(std::unique_ptr<Platform> loaded);
+};
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <cstdint>
+#include <string>
+
+// ======================================================================================
+//                           COMPTEURS DE PERFORMANCE
+// Compteurs par composant, compilés uniquement avec -DPROJC_STATS (make STATS=1, défaut).
+// En release (make release) STATS_ONLY(...) disparaît : ni membre, ni incrément.
+// Usage : STATS_ONLY(++stats.produced;)
+// ======================================================================================
+
+#ifdef PROJC_STATS
+#define STATS_ONLY(...) __VA_ARGS__
+#else
+#define STATS_ONLY(...)
+#endif
+
+struct ComponentStats {
+    std::uint64_t produced{0};      // valeurs fournies en sortie (read() valides, résultats CPU)
+    std::uint64_t consumed{0};      // valeurs prises à la source
+    std::uint64_t emptyReads{0};    // read() sans donnée disponible
+    std::uint64_t dropped{0};       // valeurs écrasées (Memory pleine)
+    std::uint64_t stallCycles{0};   // cycles actifs sans aucun transfert
+    std::uint64_t divByZero{0};     // divisions par zéro (CPU)
+    std::uint64_t samples{0};       // nombre de cycles où l'occupation a été relevée
+    std::uint64_t occupancySum{0};
+    std::uint64_t peakOccupancy{0};
+
+    void sampleOccupancy(std::uint64_t occupancy) {
+        ++samples;
+        occupancySum += occupancy;
+        if (occupancy > peakOccupancy) peakOccupancy = occupancy;
+    }
+
+    // Même occupation pendant n cycles (quantum stepping)
+    void sampleOccupancy(std::uint64_t occupancy, std::uint64_t n) {
+        if (n == 0) return;
+        samples += n;
+        occupancySum += occupancy * n;
+        if (occupancy > peakOccupancy) peakOccupancy = occupancy;
+    }
+
+    double averageOccupancy() const {
+        return samples ? static_cast<double>(occupancySum) / static_cast<double>(samples) : 0.0;
+    }
+};
+
+// ========================= Noms et échappements des rapports =========================
+// Communs aux rapports JSON/CSV (writeStats, SampledRun, bench), définis dans stats.cpp
+class CPU;
+class Memory;
+class BUS;
+class Display;
+class CoroutineComponent;
+class ReadableComponent;
+
+namespace report {
+
+const char* typeName(const CPU&);
+const char* typeName(const Memory&);
+const char* typeName(const BUS&);
+const char* typeName(const Display&);
+const char* typeName(const CoroutineComponent& c);
+
+std::string nameOf(const ReadableComponent& c);
+std::string nameOf(const Display& d);
+
+std::string jsonEscape(const std::string& s);
+std::string csvEscape(const std::string& s);
+
+} // namespace report
+
+#endif
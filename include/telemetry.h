@@ -0,0 +1,88 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "lib.h"
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+class Platform;
+
+// ======================================================================================
+//                                 TELEMETRY
+// Série temporelle de l'occupation des buffers, relevée tous les K cycles :
+//   BUS : ready et pending, MEMORY : count, CPU : profondeur du registre
+// - sample() ne fait aucune allocation : les lignes sont écrites dans un des deux blocs
+//   préalloués (double buffering) ; un bloc plein est passé au thread de flush
+// - le thread de flush réduit chaque groupe de D lignes en min/max/moyenne par colonne
+//   et écrit le bloc réduit dans le fichier, colonne par colonne
+//
+// Format du fichier (little-endian natif) :
+//   "PROJCTS1" | u32 n_cols | u32 sample_every | u32 downsample
+//   | n_cols x (u32 taille, nom)                  noms "label.ready", "label.count"...
+//   | blocs jusqu'à la fin du fichier :
+//       u32 n_rows | u64 first_cycle[n_rows]      premier cycle de chaque ligne réduite
+//       | pour chaque colonne : u32 min[n_rows] | u32 max[n_rows] | f32 avg[n_rows]
+// Relecture : outil tsdump (CSV)
+// ======================================================================================
+
+class Telemetry {
+public:
+    static constexpr char MAGIC[8] = {'P', 'R', 'O', 'J', 'C', 'T', 'S', '1'};
+
+private:
+    enum class ColumnKind { BUS_READY, BUS_PENDING, MEMORY_COUNT, CPU_REGISTER };
+    struct Column {
+        ColumnKind kind;
+        const void* component;
+    };
+
+    struct Block {
+        std::vector<std::uint64_t> cycles;
+        std::vector<std::uint32_t> values; // ligne par ligne : rows x n_cols
+        std::size_t rows{0};
+    };
+
+    std::vector<Column> columns;
+    std::vector<std::string> names;
+    std::uint32_t sampleEvery;
+    std::uint32_t downsample;
+    std::size_t rowsPerBlock;
+
+    Block blocks[2];
+    int active{0};
+
+    std::ofstream file;
+    std::thread flusher;
+    std::mutex mtx;
+    std::condition_variable cv;
+    Block* toFlush{nullptr};
+    bool stopping{false};
+
+    // Tampons de la réduction, réutilisés d'un bloc à l'autre
+    std::vector<std::uint64_t> outCycles;
+    std::vector<std::uint32_t> outMin, outMax;
+    std::vector<float> outAvg;
+
+    void flushLoop();
+    void writeBlock(const Block& block);
+    void handOff();
+
+public:
+    Telemetry(Platform& platform, const std::string& filename,
+              std::uint32_t sampleEvery, std::uint32_t downsample, std::size_t rowsPerBlock = 4096);
+    ~Telemetry();
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    bool isOpen() const { return file.is_open(); }
+    std::uint32_t getSampleEvery() const { return sampleEvery; }
+    std::size_t columnCount() const { return columns.size(); }
+
+    void sample(std::uint64_t cycle);
+    void close();
+};
+
+#endif
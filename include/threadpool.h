@@ -0,0 +1,44 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// ======================================================================================
+//                                 THREADPOOL
+// Pool de threads minimal : une file de tâches partagée par n workers
+// Méthodes pertinentes :
+//   - submit() : ajoute une tâche à la file
+//   - wait() : bloque jusqu'à ce que toutes les tâches soumises soient terminées
+// ======================================================================================
+
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mtx;
+    std::condition_variable taskAvailable;
+    std::condition_variable allDone;
+    std::size_t running{0};
+    bool stopping{false};
+
+    void workerLoop();
+
+public:
+    explicit ThreadPool(unsigned n_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    std::size_t size() const { return workers.size(); }
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef UNTIL_H
+#define UNTIL_H
+
+#include "lib.h"
+
+class Platform;
+class CPU;
+class BUS;
+class Memory;
+
+// ======================================================================================
+//                                 RUN UNTIL
+// Conditions d'arrêt de sim --until, évaluées à la fin de chaque cycle ; plusieurs
+// conditions : arrêt dès que l'une d'elles est vraie. Syntaxe (op : >= <= == != > <) :
+//   idle                         tous les CPU à l'arrêt (FREQUENCY 0 ou sans programme)
+//                                et tous les buffers vides (registres, BUS, MEMORY, DMA)
+//   mem:<label><op>N             nombre de valeurs dans la MEMORY <label>
+//   value:<label><op>V           une valeur lue par le BUS <label> pendant le cycle
+//   stat:<label>.<compteur><op>N compteur de performance (produced, consumed, emptyReads,
+//                                dropped, stallCycles, divByZero ; build PROJC_STATS)
+// add() ne fait que parser ; compile() résout les labels en pointeurs, une fois la
+// plateforme chargée, et produit la liste de vérifications parcourue par check().
+// Sans condition, la boucle principale ne crée pas de StopConditions : aucun coût.
+// ======================================================================================
+
+class StopConditions {
+private:
+    enum class Kind { IDLE, MEMORY_COUNT, BUS_VALUE, COUNTER };
+    enum class Op { GE, LE, EQ, NE, GT, LT };
+
+    struct Condition {
+        std::string spec;    // texte de --until, pour les messages
+        Kind kind;
+        std::string label;
+        std::string counter; // COUNTER seulement
+        Op op;
+        double threshold;
+    };
+
+    struct Check {
+        Kind kind;
+        Op op;
+        double threshold;
+        const void* target;  // Memory, BUS ou compteur (std::uint64_t) ; inutilisé pour IDLE
+        std::size_t condition;
+    };
+
+    std::vector<Condition> conditions;
+    std::vector<Check> checks;
+
+    // Composants parcourus par idle (remplis par compile() si une condition idle existe)
+    std::vector<const CPU*> cpus;
+    std::vector<const BUS*> buses;
+    std::vector<const Memory*> memories;
+    std::vector<const ReadableComponent*> others; // DMA et autres coroutines : hasData()
+
+    bool idle() const;
+    static bool compare(double v, Op op, double threshold);
+
+public:
+    // Parse une condition ; false (message dans le log) si la syntaxe est invalide
+    bool add(const std::string& spec);
+    // Résout les labels dans la registry de platform ; false si un label est inconnu
+    // ou n'a pas le type attendu
+    bool compile(Platform& platform);
+
+    bool empty() const { return conditions.empty(); }
+
+    // Première condition vraie à la fin du cycle courant (son texte), nullptr sinon
+    const std::string* check() const;
+};
+
+#endif
@@ -0,0 +1,210 @@
+#ifndef VALUE_H
+#define VALUE_H
+
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+
+// ======================================================================================
+//                                   VALUE
+// Type des valeurs qui circulent dans la plateforme (opérandes des instructions,
+// registres des CPU, BUS, MEMORY, DISPLAY : tout ce qui passe par DataValue), fixé à la
+// compilation :
+//   make VALUE=double   défaut
+//   make VALUE=float    simple précision : DataValue deux fois plus petit (8 octets)
+//   make VALUE=int64    entiers 64 bits, division entière, débordement modulo 2^64
+//   make VALUE=fixed    virgule fixe Q47.16 (Fixed<16>), arrondi au plus proche
+// Les opérations passent par ValueTraits<value_t>, spécialisé par type : aucun test du
+// type à l'exécution. Tous les objets d'un binaire (et un programme lié à libprojsim)
+// doivent être compilés avec la même valeur de VALUE.
+// ======================================================================================
+
+// ========================= Virgule fixe =========================
+template <int FracBits>
+struct Fixed {
+    static_assert(FracBits > 0 && FracBits < 62, "Fixed : nombre de bits fractionnaires");
+    static constexpr std::int64_t ONE = std::int64_t{1} << FracBits;
+
+    std::int64_t raw{0};
+
+    constexpr Fixed() = default;
+    // Conversion implicite depuis les littéraux (DataValue(0.0, false), programmes)
+    constexpr Fixed(double v)
+        : raw(static_cast<std::int64_t>(v * static_cast<double>(ONE) + (v < 0 ? -0.5 : 0.5))) {}
+
+    static constexpr Fixed fromRaw(std::int64_t r) {
+        Fixed f;
+        f.raw = r;
+        return f;
+    }
+    explicit constexpr operator double() const { return static_cast<double>(raw) / static_cast<double>(ONE); }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+    friend std::ostream& operator<<(std::ostream& os, Fixed f) { return os << static_cast<double>(f); }
+};
+
+// ========================= Format texte =========================
+// Écriture d'une valeur (ValueTraits::format, std::to_chars) :
+//   GENERAL   %g, comme operator<< (précision 6 par défaut)
+//   SHORTEST  représentation la plus courte qui relit exactement la même valeur
+//   FIXED     notation décimale, precision chiffres après la virgule (6 par défaut)
+//   HEX       hexadécimal flottant (0x1.8p+1 s'écrit 1.8p+1), exact par défaut
+// Les entiers (int64) s'écrivent toujours en décimal.
+enum class ValueFormat { GENERAL, SHORTEST, FIXED, HEX };
+
+inline bool parseValueFormat(const std::string& s, ValueFormat& fmt) {
+    if (s == "GENERAL") fmt = ValueFormat::GENERAL;
+    else if (s == "SHORTEST") fmt = ValueFormat::SHORTEST;
+    else if (s == "FIXED") fmt = ValueFormat::FIXED;
+    else if (s == "HEX") fmt = ValueFormat::HEX;
+    else return false;
+    return true;
+}
+
+// ========================= Opérations =========================
+// Cas général : types flottants (double, float)
+template <typename T>
+struct ValueTraits {
+    static constexpr const char* name() { return sizeof(T) == sizeof(float) ? "float" : "double"; }
+
+    static constexpr T add(T l, T r) { return l + r; }
+    static constexpr T sub(T l, T r) { return l - r; }
+    static constexpr T mul(T l, T r) { return l * r; }
+    static constexpr T div(T l, T r) { return l / r; } // r non nul (cf isZero)
+    static constexpr bool isZero(T v) { return v == T{0}; }
+
+    static constexpr T fromDouble(double v) { return static_cast<T>(v); }
+    static constexpr double toDouble(T v) { return static_cast<double>(v); }
+
+    // Lecture d'un opérande de programme
+    static bool read(std::istream& in, T& v) { return static_cast<bool>(in >> v); }
+
+    // Écrit v dans [first, last) ; precision < 0 : défaut du format.
+    // Fin du texte écrit, nullptr si la place manque
+    static char* format(char* first, char* last, T v, ValueFormat fmt, int precision) {
+        std::to_chars_result r;
+        switch (fmt) {
+            case ValueFormat::SHORTEST: r = std::to_chars(first, last, v); break;
+            case ValueFormat::FIXED:
+                r = std::to_chars(first, last, v, std::chars_format::fixed, precision < 0 ? 6 : precision);
+                break;
+            case ValueFormat::HEX:
+                r = precision < 0 ? std::to_chars(first, last, v, std::chars_format::hex)
+                                  : std::to_chars(first, last, v, std::chars_format::hex, precision);
+                break;
+            default:
+                r = std::to_chars(first, last, v, std::chars_format::general, precision < 0 ? 6 : precision);
+        }
+        return r.ec == std::errc() ? r.ptr : nullptr;
+    }
+};
+
+template <>
+struct ValueTraits<std::int64_t> {
+    using U = std::uint64_t;
+    static constexpr const char* name() { return "int64"; }
+
+    // Modulo 2^64 plutôt qu'un débordement indéfini
+    static constexpr std::int64_t add(std::int64_t l, std::int64_t r) { return static_cast<std::int64_t>(U(l) + U(r)); }
+    static constexpr std::int64_t sub(std::int64_t l, std::int64_t r) { return static_cast<std::int64_t>(U(l) - U(r)); }
+    static constexpr std::int64_t mul(std::int64_t l, std::int64_t r) { return static_cast<std::int64_t>(U(l) * U(r)); }
+    static constexpr std::int64_t div(std::int64_t l, std::int64_t r) {
+        return r == -1 ? sub(0, l) : l / r; // INT64_MIN / -1
+    }
+    static constexpr bool isZero(std::int64_t v) { return v == 0; }
+
+    static constexpr std::int64_t fromDouble(double v) { return static_cast<std::int64_t>(v); }
+    static constexpr double toDouble(std::int64_t v) { return static_cast<double>(v); }
+
+    // Entier exact si possible ("7"), sinon tronqué ("2.5" -> 2)
+    static bool read(std::istream& in, std::int64_t& v) {
+        std::string token;
+        if (!(in >> token)) return false;
+        const char* end = token.data() + token.size();
+        auto [ptr, ec] = std::from_chars(token.data(), end, v);
+        if (ec == std::errc() && ptr == end) return true;
+        char* parsed = nullptr;
+        double d = std::strtod(token.c_str(), &parsed);
+        if (parsed == token.c_str() || *parsed != '\0') {
+            in.setstate(std::ios::failbit);
+            return false;
+        }
+        v = fromDouble(d);
+        return true;
+    }
+
+    static char* format(char* first, char* last, std::int64_t v, ValueFormat, int) {
+        std::to_chars_result r = std::to_chars(first, last, v);
+        return r.ec == std::errc() ? r.ptr : nullptr;
+    }
+};
+
+template <int FracBits>
+struct ValueTraits<Fixed<FracBits>> {
+    using F = Fixed<FracBits>;
+    using U = std::uint64_t;
+    static constexpr const char* name() { return "fixed"; }
+
+    static constexpr F add(F l, F r) { return F::fromRaw(static_cast<std::int64_t>(U(l.raw) + U(r.raw))); }
+    static constexpr F sub(F l, F r) { return F::fromRaw(static_cast<std::int64_t>(U(l.raw) - U(r.raw))); }
+    // Produit et quotient sur 128 bits, tronqués au format
+    static constexpr F mul(F l, F r) {
+        return F::fromRaw(static_cast<std::int64_t>((static_cast<__int128>(l.raw) * r.raw) >> FracBits));
+    }
+    static constexpr F div(F l, F r) {
+        return F::fromRaw(static_cast<std::int64_t>((static_cast<__int128>(l.raw) * F::ONE) / r.raw));
+    }
+    static constexpr bool isZero(F v) { return v.raw == 0; }
+
+    static constexpr F fromDouble(double v) { return F(v); }
+    static constexpr double toDouble(F v) { return static_cast<double>(v); }
+
+    static bool read(std::istream& in, F& v) {
+        double d;
+        if (!(in >> d)) return false;
+        v = F(d);
+        return true;
+    }
+
+    // Exact en double (au plus 47 bits entiers, 16 fractionnaires)
+    static char* format(char* first, char* last, F v, ValueFormat fmt, int precision) {
+        return ValueTraits<double>::format(first, last, toDouble(v), fmt, precision);
+    }
+};
+
+// ========================= Type de la build =========================
+#if defined(PROJC_VALUE_FLOAT)
+using value_t = float;
+#elif defined(PROJC_VALUE_INT64)
+using value_t = std::int64_t;
+#elif defined(PROJC_VALUE_FIXED)
+using value_t = Fixed<16>;
+#else
+using value_t = double;
+#endif
+
+using Value = ValueTraits<value_t>;
+
+// Ajoute v puis une espace à out (lignes DISPLAY) ; buffer sur la pile sauf pour les
+// écritures très longues (FIXED d'une grande valeur, grande précision)
+inline void appendValue(std::string& out, value_t v, ValueFormat fmt, int precision) {
+    char text[64];
+    if (char* end = Value::format(text, text + sizeof(text), v, fmt, precision)) {
+        out.append(text, end);
+    } else {
+        std::string big(sizeof(text), '\0');
+        char* bigEnd;
+        do {
+            big.resize(big.size() * 2);
+        } while (!(bigEnd = Value::format(big.data(), big.data() + big.size(), v, fmt, precision)));
+        out.append(big.data(), bigEnd);
+    }
+    out += ' ';
+}
+
+#endif
@@ -4,6 +4,17 @@
 #include "mem.h"
 #include "bus.h"
 #include "display.h"
+#include "config.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "livestats.h"
+#include "partition.h"
+#include "sampling.h"
+#include "reload.h"
+#include "until.h"
+#include <algorithm>
+#include <csignal>
+#include <unistd.h>
 
 // ======================================================================================
 //                                 MAIN SIMULATOR
@@ -17,11 +28,107 @@ const std::string BLUE = "\033[34m";
 
 int main(int argc, char* argv[]) {
     if (argc < 2) {
-        std::cerr << RED << "Usage: " << argv[0] << " <platform_config_file>" << RESET << std::endl;
+        std::cerr << RED << "Usage: " << argv[0] << " <platform_config_file> [options]" << RESET << std::endl;
+        std::cerr << "Options:" << std::endl;
+        std::cerr << "  --load-threads N   nombre de threads pour le parsing des fichiers de config" << std::endl;
+        std::cerr << "  --stats FILE       rapport des compteurs en fin de simulation (.json ou .csv)" << std::endl;
+        std::cerr << "  --profile N        mesure chaque simulate(), affiche les N composants les plus coûteux" << std::endl;
+        std::cerr << "  --profile-folded F écrit le profil en folded stacks (flamegraph) dans F" << std::endl;
+        std::cerr << "  --profile-tsc      utilise le TSC au lieu de steady_clock pour le profiling" << std::endl;
+        std::cerr << "  --telemetry F      série temporelle de l'occupation des buffers dans F (cf tsdump)" << std::endl;
+        std::cerr << "  --telemetry-every K        relevé tous les K cycles (1)" << std::endl;
+        std::cerr << "  --telemetry-downsample D   réduction min/max/moy par groupes de D relevés (1)" << std::endl;
+        std::cerr << "  --live [NAME]      publie l'avancement en mémoire partagée (défaut /projc-<pid>, cf simtop)" << std::endl;
+        std::cerr << "  --live-every N     mise à jour tous les N cycles (1000)" << std::endl;
+        std::cerr << "  --idle-skip        simulation événementielle : saute les composants et cycles sans activité" << std::endl;
+        std::cerr << "  --dispatch MODE    lecture des sources : typed (appels inlinés, défaut) ou virtual" << std::endl;
+        std::cerr << "  --quantum Q        chaque composant avance de Q cycles par appel (1 = précis au cycle)" << std::endl;
+        std::cerr << "  --partitions N     répartit la plateforme sur N processus (BUS coupés en mémoire partagée)" << std::endl;
+        std::cerr << "  --sample P:W[:U]   simulation échantillonnée : fenêtre détaillée de W cycles (après U de" << std::endl;
+        std::cerr << "                     warmup) toutes les P cycles, fast-forward sinon ; --stats écrit les estimations" << std::endl;
+        std::cerr << "  --watch            recharge à chaud les configs modifiées (inotify, ou SIGHUP pour tout relire)" << std::endl;
+        std::cerr << "  --watch-every N    vérification tous les N cycles (1000)" << std::endl;
+        std::cerr << "  --until COND       arrêt dès que COND est vraie (répétable) ; le nombre de cycles saisi" << std::endl;
+        std::cerr << "                     devient un maximum. COND : idle, mem:LABEL>=N, value:BUS>V," << std::endl;
+        std::cerr << "                     stat:LABEL.COMPTEUR>=N (cf until.h)" << std::endl;
         return 1;
     }
 
     std::string configFile = argv[1];
+    std::string statsFile;
+    std::size_t profileTop = 0;
+    std::string profileFolded;
+    bool profileTsc = false;
+    std::string telemetryFile;
+    std::uint32_t telemetryEvery = 1;
+    std::uint32_t telemetryDownsample = 1;
+    std::string liveName;
+    std::uint64_t liveEvery = 1000;
+    bool idleSkip = false;
+    std::uint64_t quantum = 1;
+    unsigned partitions = 1;
+    std::string sampleSpec;
+    bool watch = false;
+    std::uint64_t watchEvery = 1000;
+    std::unique_ptr<StopConditions> until;
+    for (int a = 2; a < argc; ++a) {
+        std::string opt = argv[a];
+        if (opt == "--load-threads" && a + 1 < argc) {
+            ConfigCache::setThreads(static_cast<unsigned>(std::stoul(argv[++a])));
+        } else if (opt == "--stats" && a + 1 < argc) {
+            statsFile = argv[++a];
+        } else if (opt == "--profile" && a + 1 < argc) {
+            profileTop = static_cast<std::size_t>(std::stoul(argv[++a]));
+        } else if (opt == "--profile-folded" && a + 1 < argc) {
+            profileFolded = argv[++a];
+        } else if (opt == "--profile-tsc") {
+            profileTsc = true;
+        } else if (opt == "--telemetry" && a + 1 < argc) {
+            telemetryFile = argv[++a];
+        } else if (opt == "--telemetry-every" && a + 1 < argc) {
+            telemetryEvery = static_cast<std::uint32_t>(std::stoul(argv[++a]));
+        } else if (opt == "--telemetry-downsample" && a + 1 < argc) {
+            telemetryDownsample = static_cast<std::uint32_t>(std::stoul(argv[++a]));
+        } else if (opt == "--live") {
+            if (a + 1 < argc && argv[a + 1][0] == '/') liveName = argv[++a];
+            else liveName = "/projc-" + std::to_string(getpid());
+        } else if (opt == "--live-every" && a + 1 < argc) {
+            liveEvery = std::stoull(argv[++a]);
+        } else if (opt == "--idle-skip") {
+            idleSkip = true;
+        } else if (opt == "--dispatch" && a + 1 < argc) {
+            std::string mode = argv[++a];
+            if (mode != "typed" && mode != "virtual") {
+                std::cerr << RED << "Error: --dispatch expects typed or virtual" << RESET << std::endl;
+                return 1;
+            }
+            SourceHandle::setTypedDispatch(mode == "typed");
+        } else if (opt == "--quantum" && a + 1 < argc) {
+            quantum = std::stoull(argv[++a]);
+        } else if (opt == "--partitions" && a + 1 < argc) {
+            partitions = static_cast<unsigned>(std::stoul(argv[++a]));
+        } else if (opt == "--sample" && a + 1 < argc) {
+            sampleSpec = argv[++a];
+        } else if (opt == "--watch") {
+            watch = true;
+        } else if (opt == "--watch-every" && a + 1 < argc) {
+            watchEvery = std::max<std::uint64_t>(1, std::stoull(argv[++a]));
+        } else if (opt == "--until" && a + 1 < argc) {
+            if (!until) until = std::make_unique<StopConditions>();
+            if (!until->add(argv[++a])) return 1;
+        } else {
+            std::cerr << RED << "Error: unknown option " << opt << RESET << std::endl;
+            return 1;
+        }
+    }
+
+    std::uint64_t samplePeriod = 0, sampleWindow = 0, sampleWarmup = 0;
+    if (!sampleSpec.empty() && !SampledRun::parse(sampleSpec, samplePeriod, sampleWindow, sampleWarmup)) {
+        std::cerr << RED << "Error: --sample expects PERIOD:WINDOW[:WARMUP] with 0 < WINDOW and WINDOW + WARMUP <= PERIOD"
+                  << RESET << std::endl;
+        return 1;
+    }
+
     std::cout << "Config file: " << configFile << std::endl;
     Platform mainPlatform("NotLoadedPlatform");
 
@@ -33,16 +140,187 @@ int main(int argc, char* argv[]) {
     std::cout << GREEN << "Platform configuration loaded successfully, platform loaded: " 
               << mainPlatform.getLabel() << RESET << std::endl;
 
+    if (partitions > 1) {
+        // Chaque partition a ses propres compteurs et son propre processus : les options
+        // d'observation et les autres modes de simulation ne s'appliquent pas
+        if (idleSkip || quantum > 1 || profileTop > 0 || !profileFolded.empty() || !telemetryFile.empty()
+            || !liveName.empty() || !statsFile.empty() || watch || until) {
+            std::cerr << RED << "Warning: --idle-skip, --quantum, --profile, --telemetry, --live, --stats, --watch "
+                      << "and --until are ignored with --partitions" << RESET << std::endl;
+        }
+
+        PartitionedRun partitioned(mainPlatform, partitions);
+        partitioned.printPlan(std::cout);
+
+        int cycles{1};
+        std::cout << YELLOW << "Enter number of simulation cycles: " << RESET;
+        std::cin >> cycles;
+
+        if (!partitioned.run(cycles > 0 ? static_cast<std::uint64_t>(cycles) : 0, std::cout)) {
+            std::cerr << RED << "Error: Partitioned simulation failed." << RESET << std::endl;
+            return 1;
+        }
+        std::cout << GREEN << "Simulation completed after " << cycles << " cycles." << RESET << std::endl;
+        std::cout << "Final Platform State:" << BLUE << std::endl;
+        mainPlatform.printInfo();
+        std::cout << RESET << std::endl;
+        return 0;
+    }
+
+    if (!sampleSpec.empty()) {
+        // Le fast-forward ne tient pas l'état du Scheduler à jour, et les relevés par cycle
+        // n'auraient de sens que dans les fenêtres détaillées
+        if (idleSkip || profileTop > 0 || !profileFolded.empty() || !telemetryFile.empty() || !liveName.empty()
+            || watch || until) {
+            std::cerr << RED << "Warning: --idle-skip, --profile, --telemetry, --live, --watch and --until are ignored "
+                      << "with --sample" << RESET << std::endl;
+        }
+        mainPlatform.setQuantum(quantum);
+
+        int cycles{1};
+        std::cout << YELLOW << "Enter number of simulation cycles: " << RESET;
+        std::cin >> cycles;
+
+        SampledRun sampled(mainPlatform, samplePeriod, sampleWindow, sampleWarmup);
+        sampled.run(cycles > 0 ? static_cast<std::uint64_t>(cycles) : 0);
+
+        std::cout << GREEN << "Simulation completed after " << cycles << " cycles." << RESET << std::endl;
+        std::cout << "Final Platform State:" << BLUE << std::endl;
+        mainPlatform.printInfo();
+        std::cout << RESET << std::endl;
+
+#ifdef PROJC_STATS
+        sampled.writeReport(std::cout, "text");
+#else
+        std::cerr << RED << "Warning: performance counters are disabled in this build (make STATS=1), "
+                  << "no estimate available" << RESET << std::endl;
+#endif
+        if (!statsFile.empty()) {
+            bool csv = statsFile.size() >= 4 && statsFile.compare(statsFile.size() - 4, 4, ".csv") == 0;
+            std::ofstream out(statsFile);
+            if (!out.is_open()) {
+                std::cerr << RED << "Error: Could not open " << statsFile << RESET << std::endl;
+            } else {
+                sampled.writeReport(out, csv ? "csv" : "json");
+                std::cout << GREEN << "Sampled estimates written to " << statsFile << RESET << std::endl;
+            }
+        }
+        return 0;
+    }
+
+    std::unique_ptr<Profiler> profiler;
+    if (idleSkip && (profileTop > 0 || !profileFolded.empty())) {
+        std::cerr << RED << "Warning: profiling is not available with --idle-skip, ignored" << RESET << std::endl;
+        profileTop = 0;
+        profileFolded.clear();
+    }
+    if (idleSkip && quantum > 1) {
+        std::cerr << RED << "Warning: --quantum is ignored with --idle-skip" << RESET << std::endl;
+        quantum = 1;
+    }
+    mainPlatform.setIdleSkipping(idleSkip);
+    mainPlatform.setQuantum(quantum);
+    if (profileTop > 0 || !profileFolded.empty()) {
+        profiler = std::make_unique<Profiler>(profileTsc ? Profiler::ClockSource::TSC : Profiler::ClockSource::STEADY);
+        mainPlatform.setProfiler(profiler.get());
+    }
+
+    std::unique_ptr<Telemetry> telemetry;
+    if (!telemetryFile.empty()) {
+        telemetry = std::make_unique<Telemetry>(mainPlatform, telemetryFile, telemetryEvery, telemetryDownsample);
+        if (!telemetry->isOpen()) return 1;
+    }
+    std::uint64_t nextSample = telemetry ? telemetry->getSampleEvery() : 0;
+
+    // Conditions d'arrêt : labels résolus une fois, avant le premier cycle
+    if (until && !until->compile(mainPlatform)) return 1;
+
     int cycles{1};
-    std::cout << YELLOW << "Enter number of simulation cycles: " << RESET;
+    std::cout << YELLOW << (until ? "Enter maximum number of simulation cycles: " : "Enter number of simulation cycles: ")
+              << RESET;
     std::cin >> cycles;
 
-    for(int i = 0; i < cycles; ++i) {
-        std::cout << YELLOW << "=== Cycle " << (i + 1) << " ===" << RESET << std::endl;
-        mainPlatform.simulate();
+    std::unique_ptr<LiveStats> liveStats;
+    if (!liveName.empty()) {
+        liveStats = std::make_unique<LiveStats>(mainPlatform, liveName, liveEvery, static_cast<std::uint64_t>(cycles));
+        if (liveStats->isOpen()) {
+            std::cout << GREEN << "Live stats published in " << liveName << " (simtop " << liveName << ")" << RESET << std::endl;
+        }
+    }
+    std::uint64_t nextLive = liveStats ? liveStats->getInterval() : 0;
+
+    // Rechargement à chaud : changements appliqués entre deux cycles, données conservées
+    std::unique_ptr<HotReload> reload;
+    if (watch) {
+        reload = std::make_unique<HotReload>(mainPlatform);
+        std::signal(SIGHUP, [](int) { HotReload::request(); });
+        std::cout << GREEN << "Watching " << reload->fileCount() << " config file(s), every " << watchEvery
+                  << " cycles (kill -HUP " << getpid() << " to reload all)" << RESET << std::endl;
     }
+    std::uint64_t nextReload = reload ? watchEvery : 0;
 
-    std::cout << GREEN << "Simulation completed after " << cycles << " cycles." << RESET << std::endl;
+    std::uint64_t done = 0;
+    const std::string* stoppedBy = nullptr; // condition --until atteinte
+    if (!idleSkip && quantum <= 1) {
+        for(int i = 0; i < cycles && !stoppedBy; ++i) {
+            std::cout << YELLOW << "=== Cycle " << (i + 1) << " ===" << RESET << std::endl;
+            mainPlatform.simulate();
+            done = static_cast<std::uint64_t>(i + 1);
+            if (telemetry && static_cast<std::uint64_t>(i + 1) == nextSample) {
+                telemetry->sample(nextSample);
+                nextSample += telemetry->getSampleEvery();
+            }
+            if (liveStats && static_cast<std::uint64_t>(i + 1) == nextLive) {
+                liveStats->update(nextLive);
+                nextLive += liveStats->getInterval();
+            }
+            if (reload && static_cast<std::uint64_t>(i + 1) == nextReload) {
+                reload->poll();
+                nextReload += watchEvery;
+            }
+            if (until) stoppedBy = until->check();
+        }
+    } else {
+        // Pas de bannière par cycle : les cycles sont avancés par tranches, jusqu'au prochain
+        // relevé de télémétrie, de live stats ou de rechargement (une bannière par quantum).
+        // Avec --until, tranches d'un cycle en idle skipping, vérification par quantum sinon
+        std::uint64_t total = cycles > 0 ? static_cast<std::uint64_t>(cycles) : 0;
+        while (done < total && !stoppedBy) {
+            std::uint64_t stop = total;
+            if (quantum > 1) stop = std::min(stop, done + quantum);
+            else if (until) stop = done + 1;
+            if (telemetry) stop = std::min(stop, nextSample);
+            if (liveStats) stop = std::min(stop, nextLive);
+            if (reload) stop = std::min(stop, nextReload);
+            if (quantum > 1) {
+                std::cout << YELLOW << "=== Cycles " << (done + 1) << "-" << stop << " ===" << RESET << std::endl;
+            }
+            mainPlatform.run(stop - done);
+            done = stop;
+            if (telemetry && done == nextSample) {
+                telemetry->sample(nextSample);
+                nextSample += telemetry->getSampleEvery();
+            }
+            if (liveStats && done == nextLive) {
+                liveStats->update(nextLive);
+                nextLive += liveStats->getInterval();
+            }
+            if (reload && done == nextReload) {
+                reload->poll();
+                nextReload += watchEvery;
+            }
+            if (until) stoppedBy = until->check();
+        }
+    }
+    if (liveStats) liveStats->update(done);
+    if (telemetry) telemetry->close();
+
+    if (stoppedBy) {
+        std::cout << GREEN << "Stopped at cycle " << done << ": " << *stoppedBy << RESET << std::endl;
+    } else if (until) {
+        std::cout << RED << "Warning: no --until condition reached after " << done << " cycles" << RESET << std::endl;
+    }
+    std::cout << GREEN << "Simulation completed after " << done << " cycles." << RESET << std::endl;
     std::cout << "Final Platform State:" << BLUE << std::endl;
     mainPlatform.printInfo();
     std::cout << RESET << std::endl;
@@ -55,5 +333,30 @@ int main(int argc, char* argv[]) {
         registry.printAllComponents();
     } std::cout << RESET << std::endl;
 
+    if (profiler) {
+        if (profileTop > 0) profiler->writeTop(std::cout, profileTop);
+        if (!profileFolded.empty()) {
+            std::ofstream out(profileFolded);
+            if (!out.is_open()) {
+                std::cerr << RED << "Error: Could not open " << profileFolded << RESET << std::endl;
+            } else {
+                profiler->writeFolded(out);
+                std::cout << GREEN << "Folded profile written to " << profileFolded << RESET << std::endl;
+            }
+        }
+    }
+
+    if (!statsFile.empty()) {
+        bool csv = statsFile.size() >= 4 && statsFile.compare(statsFile.size() - 4, 4, ".csv") == 0;
+        std::ofstream out(statsFile);
+        if (!out.is_open()) {
+            std::cerr << RED << "Error: Could not open " << statsFile << RESET << std::endl;
+        } else if (!mainPlatform.writeStats(out, csv ? "csv" : "json")) {
+            std::cerr << RED << "Warning: performance counters are disabled in this build (make STATS=1)" << RESET << std::endl;
+        } else {
+            std::cout << GREEN << "Statistics written to " << statsFile << RESET << std::endl;
+        }
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "arena.h"
+#include <algorithm>
+
+// ========================= Constructor / Destructor =========================
+Arena::Arena(std::size_t chunkBytes)
+    : chunkSize(chunkBytes ? chunkBytes : 1)
+{}
+
+Arena::~Arena() {
+    for (auto it = destructors.rbegin(); it != destructors.rend(); ++it) it->destroy(it->object);
+}
+
+// ========================= Allocate =========================
+void* Arena::allocate(std::size_t bytes, std::size_t align) {
+    if (!chunks.empty()) {
+        Chunk& c = chunks.back();
+        std::size_t offset = (c.used + align - 1) & ~(align - 1);
+        if (offset + bytes <= c.size) {
+            c.used = offset + bytes;
+            return c.data.get() + offset;
+        }
+    }
+    // Nouveau bloc ; les blocs de new[] sont alignés pour tout type standard
+    std::size_t size = std::max(chunkSize, bytes);
+    chunks.push_back({std::make_unique<std::byte[]>(size), size, bytes});
+    return chunks.back().data.get();
+}
+
+std::size_t Arena::bytesUsed() const {
+    std::size_t n = 0;
+    for (const auto& c : chunks) n += c.used;
+    return n;
+}
+
+std::size_t Arena::bytesReserved() const {
+    std::size_t n = 0;
+    for (const auto& c : chunks) n += c.size;
+    return n;
+}
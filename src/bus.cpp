@@ -1,4 +1,6 @@
 #include "bus.h"
+#include "dispatch.h"
+#include "config.h"
 
 BUS::BUS(const std::string& lbl)
     : ReadableComponent(lbl)
@@ -8,14 +10,14 @@ BUS::~BUS() = default;
 
 void BUS::bindSource(const std::string& sourceLabel) {
     if (sourceLabel == getLabel()) {
-        std::cerr << "Error: BUS '" << label << "' cannot bind to itself as source.\n";
+        Log::error() << "Error: BUS '" << label << "' cannot bind to itself as source.";
         source = nullptr;
         return;
     }
 
     source = ReadableComponentRegistry::getComponentByLabel(sourceLabel);
     if (!source) {
-        std::cerr << "Source with label \"" << sourceLabel << "\" not found\n";
+        Log::error() << "Source with label \"" << sourceLabel << "\" not found";
     }
 }
 
@@ -30,22 +32,82 @@ void BUS::simulate() {
         pending.pop();
     }
 
-    if (!source) return;
+    if (!source) {
+        STATS_ONLY(stats.sampleOccupancy(ready.size());)
+        return;
+    }
 
     // Étape 2 : lecture de la source
     for (int i = 0; i < width; ++i) {
-        DataValue data = source->read();
+        DataValue data = source.read();
         if (!data.valid) break; // arrêt si donnée invalide
         pending.push(data);
     }
+
+    STATS_ONLY(
+        stats.consumed += pending.size();
+        if (pending.empty()) ++stats.stallCycles;
+        stats.sampleOccupancy(ready.size() + pending.size());
+    )
+}
+
+// Source inchangée pendant le quantum : dès qu'un cycle ne lit plus rien, pending est
+// vide et les cycles suivants ne transfèrent plus rien (seuls les compteurs avancent ;
+// les read() vides sur la source ne sont alors plus comptés)
+void BUS::simulate(std::uint64_t cycles) {
+    for (std::uint64_t i = 0; i < cycles; ++i) {
+        BUS::simulate();
+        if (pending.empty()) {
+            STATS_ONLY(
+                std::uint64_t rest = cycles - i - 1;
+                if (source) stats.stallCycles += rest;
+                stats.sampleOccupancy(ready.size(), rest);
+            )
+            return;
+        }
+    }
+}
+
+// ========================= Fast-forward =========================
+void BUS::fastForward(std::uint64_t cycles) {
+    while (!pending.empty()) {
+        ready.push(pending.front());
+        pending.pop();
+    }
+    if (!source) return;
+    for (std::uint64_t budget = static_cast<std::uint64_t>(width > 0 ? width : 0) * cycles; budget > 0; --budget) {
+        DataValue data = source.read();
+        if (!data.valid) break;
+        ready.push(data);
+    }
+}
+
+// ========================= BUS coupé =========================
+std::size_t BUS::fetch(DataValue* out) {
+    std::size_t n = 0;
+    if (source) {
+        for (int i = 0; i < width; ++i) {
+            DataValue data = source.read();
+            if (!data.valid) break;
+            out[n++] = data;
+        }
+    }
+    STATS_ONLY(
+        stats.consumed += n;
+        if (n == 0) ++stats.stallCycles;
+    )
+    return n;
 }
 
-DataValue BUS::read() {
-    if (ready.empty()) return DataValue(0.0, false);
-    DataValue data = ready.front();
-    ready.pop();
-    readCount++;
-    return data;
+void BUS::deliver(const DataValue* values, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) ready.push(values[i]);
+    STATS_ONLY(stats.sampleOccupancy(ready.size());)
+}
+
+// Actif tant qu'il reste des données en transit ou à lire, endormi sinon
+std::uint64_t BUS::nextWakeup(std::uint64_t now) const {
+    if (!pending.empty() || (source && source.hasData())) return now + 1;
+    return NEVER;
 }
 
 void BUS::printInfo() const {
@@ -57,53 +119,52 @@ void BUS::printInfo() const {
               << " reads=" << readCount
               << std::endl;
 
-    std::queue<DataValue> copy = ready;  // copie pour ne pas détruire l'original
     std::cout << "Ready: ";
-    while (!copy.empty()) {
-        const DataValue& dv = copy.front();
-        std::cout << dv.value << " ";
-        copy.pop();
+    for (std::size_t i = 0; i < ready.size(); ++i) {
+        std::cout << ready[i].value << " ";
     }
     std::cout << std::endl;
-    std::queue<DataValue> copyPending = pending;  // copie pour ne pas détruire l'original
     std::cout << "Pending: ";
-    while (!copyPending.empty()) {
-        const DataValue& dv = copyPending.front();
-        std::cout << dv.value << " ";
-        copyPending.pop();
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        std::cout << pending[i].value << " ";
     }
     std::cout << std::endl;
 }
 
+// Les données en transit sont conservées, la nouvelle largeur s'applique à la lecture suivante
+bool BUS::setParam(const std::string& key, const std::string& value) {
+    if (key != "WIDTH") return Component::setParam(key, value);
+    try {
+        int w = std::stoi(value);
+        if (w <= 0) return false;
+        width = w;
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
 bool BUS::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open " << filename << std::endl;
+    auto cfg = ConfigCache::getConfig(filename);
+    if (!cfg) {
+        Log::error() << "Error: Could not open " << filename;
         return false;
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-        std::istringstream iss(line);
-
-        std::string key, value;
-        if (std::getline(iss, key, ':') && std::getline(iss, value)) {
-            key = trim(key);
-            value = trim(value);
-
-            if (key == "TYPE") {
-                if (value != "BUS") {
-                    std::cerr << "Error: TYPE must be 'BUS', found '" << value << "' instead." << std::endl;
-                    return false;
-                }
-            } else if (key == "LABEL") {
-                setLabel(value);
-            } else if (key == "WIDTH") {
-                width = std::stoi(value);
-            } else if (key == "SOURCE") {
-                bindSource(value);
+    for (const auto& [key, value] : cfg->entries) {
+        if (key == "TYPE") {
+            if (value != "BUS") {
+                Log::error() << "Error: TYPE must be 'BUS', found '" << value << "' instead.";
+                return false;
             }
+        } else if (key == "LABEL") {
+            setLabel(value);
+        } else if (key == "WIDTH") {
+            width = std::stoi(value);
+        } else if (key == "SOURCE") {
+            bindSource(value);
+        } else if (key == "CLOCK") {
+            parseClock(value);
         }
     }
     return true;
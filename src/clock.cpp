@@ -0,0 +1,53 @@
+#include "clock.h"
+#include <numeric>
+#include <sstream>
+
+// ========================= Parse =========================
+bool Clock::parse(const std::string& value) {
+    std::istringstream is(value);
+    std::string rate;
+    long long ph = 0;
+    if (!(is >> rate)) return false;
+    if (!(is >> ph)) {
+        if (!is.eof()) return false;
+        ph = 0;
+    }
+    std::string rest;
+    if (is >> rest) return false;
+
+    long long n = 1;
+    long long d = 1;
+    try {
+        std::size_t slash = rate.find('/');
+        std::size_t used = 0;
+        if (slash == std::string::npos) {
+            d = std::stoll(rate, &used);
+            if (used != rate.size()) return false;
+        } else {
+            std::string ns = rate.substr(0, slash);
+            std::string ds = rate.substr(slash + 1);
+            n = std::stoll(ns, &used);
+            if (used != ns.size()) return false;
+            d = std::stoll(ds, &used);
+            if (used != ds.size()) return false;
+        }
+    } catch (...) {
+        return false;
+    }
+
+    if (n <= 0 || n > d || d > UINT32_MAX || ph < 0 || ph >= d) return false;
+    // N/D réduit : le motif des fronts ne dépend que de la phase modulo le dénominateur
+    long long g = std::gcd(n, d);
+    num = static_cast<std::uint32_t>(n / g);
+    den = static_cast<std::uint32_t>(d / g);
+    phase = static_cast<std::uint32_t>(ph % (d / g));
+    return true;
+}
+
+std::string Clock::toString() const {
+    std::ostringstream os;
+    if (num == 1) os << den;
+    else os << num << '/' << den;
+    if (phase) os << ' ' << phase;
+    return os.str();
+}
@@ -0,0 +1,232 @@
+#include "config.h"
+#include "threadpool.h"
+#include "image.h"
+#include <cstring>
+#include <algorithm>
+#include <unordered_set>
+
+// ========================= Lecture / parsing =========================
+// Une image de plateforme n'est pas lue au-delà de son magic (loadImage la mappe)
+bool ConfigCache::readFile(const std::string& path, std::string& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    char magic[sizeof(image::MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (file && std::memcmp(magic, image::MAGIC, sizeof(magic)) == 0) {
+        content.assign(magic, sizeof(magic));
+        return true;
+    }
+    file.clear();
+    file.seekg(0);
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    content = ss.str();
+    return true;
+}
+
+std::shared_ptr<const ConfigFile> ConfigCache::parseConfig(const std::string& content) {
+    auto cfg = std::make_shared<ConfigFile>();
+    if (content.size() == sizeof(image::MAGIC) && std::memcmp(content.data(), image::MAGIC, sizeof(image::MAGIC)) == 0) {
+        cfg->image = true;
+        return cfg;
+    }
+    std::istringstream file(content);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        std::istringstream iss(line);
+        std::string key, value;
+        if (std::getline(iss, key, ':') && std::getline(iss, value)) {
+            cfg->entries.emplace_back(trim(key), trim(value));
+        }
+    }
+    return cfg;
+}
+
+std::shared_ptr<const InstructionList> ConfigCache::parseProgram(const std::string& content) {
+    auto prog = std::make_shared<InstructionList>();
+    std::istringstream file(content);
+
+    std::string opcode_str;
+    OPCODE opcode;
+    value_t op_l, op_r;
+
+    while (file >> opcode_str && Value::read(file, op_l) && Value::read(file, op_r)) {
+        if (opcode_str == "ADD")
+            opcode = ADD;
+        else if (opcode_str == "SUB")
+            opcode = SUB;
+        else if (opcode_str == "MUL")
+            opcode = MUL;
+        else if (opcode_str == "DIV")
+            opcode = DIV;
+        else
+            opcode = NOP;
+
+        prog->emplace_back(opcode, op_l, op_r);
+    }
+    return prog;
+}
+
+// ========================= Accès au cache =========================
+std::shared_ptr<const ConfigFile> ConfigCache::getConfig(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = configByPath.find(path);
+        if (it != configByPath.end()) return it->second;
+    }
+
+    // Lecture et parsing hors verrou : plusieurs fichiers peuvent être traités en parallèle
+    std::string content;
+    std::shared_ptr<const ConfigFile> parsed;
+    bool opened = readFile(path, content);
+    if (opened) parsed = parseConfig(content);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = configByPath.find(path);
+    if (it != configByPath.end()) return it->second; // un autre thread a été plus rapide
+    if (opened) {
+        auto shared = configByContent.emplace(std::move(content), parsed).first->second;
+        parsed = shared;
+    }
+    configByPath.emplace(path, parsed);
+    return parsed;
+}
+
+std::string ConfigCache::componentType(const std::string& path) {
+    auto cfg = getConfig(path);
+    if (cfg) {
+        if (cfg->image) return "IMAGE";
+        std::string type = cfg->get("TYPE");
+        if (!type.empty()) return type;
+    }
+
+    std::string name = path.substr(path.find_last_of('/') + 1);
+    if (name.find("cpu") != std::string::npos) return "CPU";
+    if (name.find("mem") != std::string::npos) return "MEMORY";
+    if (name.find("bus") != std::string::npos) return "BUS";
+    if (name.find("display") != std::string::npos) return "DISPLAY";
+    if (name.find("platform") != std::string::npos) return "PLATFORM";
+    return "";
+}
+
+std::shared_ptr<const InstructionList> ConfigCache::getProgram(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = programByPath.find(path);
+        if (it != programByPath.end()) return it->second;
+    }
+
+    std::string content;
+    std::shared_ptr<const InstructionList> parsed;
+    bool opened = readFile(path, content);
+    if (opened) parsed = parseProgram(content);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = programByPath.find(path);
+    if (it != programByPath.end()) return it->second;
+    if (opened) {
+        auto known = programByContent.find(content);
+        if (known != programByContent.end()) {
+            parsed = known->second;
+        } else {
+            parsed = internLocked(parsed);
+            programByContent.emplace(std::move(content), parsed);
+        }
+    }
+    programByPath.emplace(path, parsed);
+    return parsed;
+}
+
+// Clé d'une liste d'instructions : octets de l'opcode et des deux opérandes, champ par
+// champ (le padding d'Instruction n'est pas initialisé)
+static std::string codeKey(const InstructionList& code) {
+    std::string key;
+    key.reserve(code.size() * (1 + 2 * sizeof(value_t)));
+    for (const Instruction& instr : code) {
+        value_t operands[2] = {instr.left(), instr.right()};
+        key.push_back(static_cast<char>(instr.opcode));
+        key.append(reinterpret_cast<const char*>(operands), sizeof(operands));
+    }
+    return key;
+}
+
+std::shared_ptr<const InstructionList> ConfigCache::internLocked(std::shared_ptr<const InstructionList> code) {
+    return programByCode.emplace(codeKey(*code), std::move(code)).first->second;
+}
+
+std::shared_ptr<const InstructionList> ConfigCache::internProgram(InstructionList code) {
+    auto fresh = std::make_shared<const InstructionList>(std::move(code));
+    std::lock_guard<std::mutex> lock(mtx);
+    return internLocked(std::move(fresh));
+}
+
+std::size_t ConfigCache::programCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return programByCode.size();
+}
+
+std::shared_ptr<const ConfigFile> ConfigCache::reloadConfig(const std::string& path) {
+    std::string content;
+    if (!readFile(path, content)) return nullptr;
+    auto parsed = parseConfig(content);
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto shared = configByContent.emplace(std::move(content), parsed).first->second;
+    configByPath[path] = shared;
+    return shared;
+}
+
+bool ConfigCache::isCached(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return configByPath.count(path) != 0;
+}
+
+void ConfigCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    configByPath.clear();
+    programByPath.clear();
+    configByContent.clear();
+    programByContent.clear();
+    programByCode.clear();
+}
+
+// ========================= Prefetch parallèle =========================
+void ConfigCache::prefetch(const std::string& rootFile) {
+    unsigned n = n_threads;
+    if (n == 0) n = std::max(4u, std::thread::hardware_concurrency());
+    ThreadPool pool(n);
+
+    std::unordered_set<std::string> seen{rootFile};
+    std::vector<std::string> configs{rootFile};
+    std::vector<std::string> programs;
+
+    while (!configs.empty() || !programs.empty()) {
+        std::vector<std::shared_ptr<const ConfigFile>> results(configs.size());
+        for (std::size_t i = 0; i < configs.size(); ++i) {
+            pool.submit([&, i] { results[i] = getConfig(configs[i]); });
+        }
+        for (const auto& p : programs) {
+            pool.submit([&p] { getProgram(p); });
+        }
+        pool.wait();
+
+        // Niveau suivant : sous-composants des PLATFORM et programmes des CPU
+        std::vector<std::string> nextConfigs, nextPrograms;
+        for (std::size_t i = 0; i < configs.size(); ++i) {
+            const auto& cfg = results[i];
+            if (!cfg) continue;
+            // Même règle que le chargement : TYPE, puis nom du fichier (déjà en cache)
+            std::string type = componentType(configs[i]);
+            for (const auto& [key, value] : cfg->entries) {
+                if (type == "PLATFORM" && key == "COMPONENT") {
+                    if (seen.insert(value).second) nextConfigs.push_back(value);
+                } else if (type == "CPU" && key == "PROGRAM") {
+                    if (seen.insert("#program:" + value).second) nextPrograms.push_back(value);
+                }
+            }
+        }
+        configs.swap(nextConfigs);
+        programs.swap(nextPrograms);
+    }
+}
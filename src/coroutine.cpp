@@ -0,0 +1,133 @@
+#include "coroutine.h"
+#include <algorithm>
+
+// ========================= Behavior =========================
+CoroutineComponent::Behavior& CoroutineComponent::Behavior::operator=(Behavior&& other) noexcept {
+    if (this != &other) {
+        if (handle) handle.destroy();
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+CoroutineComponent::Behavior::~Behavior() {
+    if (handle) handle.destroy();
+}
+
+// ========================= Source =========================
+void CoroutineComponent::bindSource(const std::string& lbl) {
+    if (lbl == getLabel()) {
+        Log::error() << "Error: " << typeName() << " '" << label << "' cannot bind to itself as source.";
+        source = nullptr;
+        return;
+    }
+    sourceLabelStored = lbl;
+    source = ReadableComponentRegistry::getComponentByLabel(lbl); // sinon résolue au premier simulate()
+}
+
+void CoroutineComponent::bindSource(ReadableComponent* src) {
+    source = src;
+    sourceLabelStored = src ? src->getLabel() : "";
+}
+
+ReadableComponent* CoroutineComponent::getSource() {
+    if (!source && !sourceLabelStored.empty()) {
+        source = ReadableComponentRegistry::getComponentByLabel(sourceLabelStored);
+    }
+    return source.get();
+}
+
+std::string CoroutineComponent::getSourceLabel() const {
+    return source ? source->getLabel() : (sourceLabelStored.empty() ? "No source" : sourceLabelStored);
+}
+
+bool CoroutineComponent::parseCommonKey(const std::string& key, const std::string& value) {
+    if (key == "LABEL") setLabel(value);
+    else if (key == "SOURCE") bindSource(value);
+    else if (key == "CLOCK") parseClock(value);
+    else return false;
+    return true;
+}
+
+// ========================= Données =========================
+DataValue CoroutineComponent::take() {
+    if (!source) return DataValue(0.0, false);
+    DataValue dv = source.read();
+    STATS_ONLY(if (dv.valid) ++stats.consumed;)
+    return dv;
+}
+
+void CoroutineComponent::emit(const DataValue& v) {
+    output.push(v);
+}
+
+DataValue CoroutineComponent::read() {
+    if (output.empty()) {
+        STATS_ONLY(++stats.emptyReads;)
+        return DataValue(0.0, false);
+    }
+    DataValue dv = output.front();
+    output.pop();
+    STATS_ONLY(++stats.produced;)
+    return dv;
+}
+
+// ========================= Simulate =========================
+bool CoroutineComponent::ready() {
+    switch (wait) {
+        case Wait::START: return true;
+        case Wait::CYCLES: return cycle >= wakeAt;
+        case Wait::DATA: return getSource() && source.hasData();
+        case Wait::DONE: return false;
+    }
+    return false;
+}
+
+// Reprend la coroutine jusqu'à sa prochaine attente
+void CoroutineComponent::step() {
+    if (wait == Wait::START) coroutine = behavior();
+    wait = Wait::DONE; // remplacé par l'awaiter si la coroutine se suspend
+    coroutine.resume();
+    if (coroutine.done()) wait = Wait::DONE;
+}
+
+void CoroutineComponent::simulate() {
+    ++cycle;
+    if (ready()) step();
+    STATS_ONLY(
+        if (wait == Wait::DATA) ++stats.stallCycles;
+        stats.sampleOccupancy(output.size());
+    )
+}
+
+// Quantum : les cycles d'attente d'un co_await cycles(n) sont sautés d'un coup
+void CoroutineComponent::simulate(std::uint64_t n) {
+    while (n > 0) {
+        if (wait == Wait::DONE) {
+            cycle += n;
+            return;
+        }
+        if (wait == Wait::CYCLES && wakeAt > cycle + 1) {
+            std::uint64_t idle = std::min(n, wakeAt - cycle - 1);
+            cycle += idle;
+            n -= idle;
+            STATS_ONLY(stats.sampleOccupancy(output.size(), idle);)
+            if (n == 0) return;
+        }
+        CoroutineComponent::simulate();
+        --n;
+    }
+}
+
+std::uint64_t CoroutineComponent::nextWakeup(std::uint64_t now) const {
+    switch (wait) {
+        case Wait::START: return now + 1;
+        case Wait::CYCLES: return wakeAt > cycle ? now + (wakeAt - cycle) : now + 1;
+        case Wait::DATA:
+            if (!source) return sourceLabelStored.empty() ? NEVER : now + 1;
+            return source.hasData() ? now + 1 : NEVER;
+        case Wait::DONE: return NEVER;
+    }
+    return now + 1;
+}
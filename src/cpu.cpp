@@ -1,119 +1,110 @@
 #include "cpu.h"
+#include "config.h"
 #include <sstream>
 #include <fstream>
 #include <string>
 
-double Instruction::compute() {
+value_t Instruction::compute() {
     switch (opcode) {
         case ADD:
-            return operand_l + operand_r;
+            return Value::add(operand_l, operand_r);
         case SUB:
-            return operand_l - operand_r;
+            return Value::sub(operand_l, operand_r);
         case MUL:
-            return operand_l * operand_r;
+            return Value::mul(operand_l, operand_r);
         case DIV:
-            if (operand_r != 0.0) {
-                return operand_l / operand_r;
+            if (!Value::isZero(operand_r)) {
+                return Value::div(operand_l, operand_r);
             } else {
-                std::cerr << "Error: Division by zero." << std::endl;
-                return 0.0;
+                Log::error() << "Error: Division by zero.";
+                return value_t{};
             }
         case NOP:
-            return 0.0;
+            return value_t{};
     }
-    return 0.0; //fallback
+    return value_t{}; //fallback
 }
 
 void Program::load(const std::string &filename) {
-    instructions.clear();
-    std::ifstream file(filename);
+    assign(nullptr);
+    auto parsed = ConfigCache::getProgram(filename);
 
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open program file: " << filename << std::endl;
+    if (!parsed) {
+        Log::error() << "Error: Could not open program file: " << filename;
         return;
     }
 
-    std::string opcode_str;
-    OPCODE opcode;
-    double op_l, op_r;
-
-    while (file >> opcode_str >> op_l >> op_r) {
-        if (opcode_str == "ADD")
-            opcode = ADD;
-        else if (opcode_str == "SUB")
-            opcode = SUB;
-        else if (opcode_str == "MUL")
-            opcode = MUL;
-        else if (opcode_str == "DIV")
-            opcode = DIV;
-        else
-            opcode = NOP;
-        
-        instructions.emplace_back(opcode, op_l, op_r); // Ajouter l'instruction à la fin de la liste
-    }
+    assign(std::move(parsed)); // image du cache, aucune copie
+}
 
-    reset();
+void Program::assign(const Instruction* first, std::size_t n) {
+    assign(n ? ConfigCache::internProgram(InstructionList(first, first + n)) : nullptr);
 }
 
 Instruction Program::compute() {
-    if (pc == instructions.end()) {
+    if (pc == length) {
         reset();
         return Instruction(NOP);
     }
     else {
-        Instruction instr = *pc;
-        ++pc;
-        return instr;
+        return code[pc++];
     }
 }
 
 bool CPU::loadFromFile(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Error: Could not open " << filename << std::endl;
+        auto cfg = ConfigCache::getConfig(filename);
+        if (!cfg) {
+            Log::error() << "Error: Could not open " << filename;
             return false;
         }
-        std::string line, key, value, type;
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
-            std::istringstream iss(line);
-            if (std::getline(iss, key, ':') && std::getline(iss, value)) {
-                key = trim(key);
-                value = trim(value);
-                if (key == "TYPE") {
-                    if (value != "CPU") {
-                        std::cerr << "Error: TYPE must be 'CPU', found '" << value << "' instead." << std::endl;
-                        return false;
-                    }
-                }
-                else if (key == "LABEL") setLabel(value);
-                else if (key == "CORES") setNCores(stoi(value));
-                else if (key == "FREQUENCY") setFrequency(stoi(value));
-                else if (key == "PROGRAM") loadProgram(value);
-                else {
-                    std::cerr << "Warning: Unknown key '" << key << "' in " << filename << std::endl;
+        for (const auto& [key, value] : cfg->entries) {
+            if (key == "TYPE") {
+                if (value != "CPU") {
+                    Log::error() << "Error: TYPE must be 'CPU', found '" << value << "' instead.";
+                    return false;
                 }
             }
+            else if (key == "LABEL") setLabel(value);
+            else if (key == "CORES") setNCores(stoi(value));
+            else if (key == "FREQUENCY") setFrequency(stoi(value));
+            else if (key == "PROGRAM") loadProgram(value);
+            else if (key == "CLOCK") parseClock(value);
+            else {
+                Log::warning() << "Warning: Unknown key '" << key << "' in " << filename;
+            }
         }
         return true;
 }
 
+// FREQUENCY et CORES prennent effet au cycle suivant (programme conservé)
+bool CPU::setParam(const std::string& key, const std::string& value) {
+    int v;
+    try { v = std::stoi(value); }
+    catch (...) { return Component::setParam(key, value); }
+    if (key == "FREQUENCY" && v >= 0) setFrequency(v);
+    else if (key == "CORES" && v > 0) setNCores(v);
+    else return Component::setParam(key, value);
+    return true;
+}
+
 DataValue Register::pop() {
     if (fifo.empty()) {
         return DataValue(0.0, false);
     }
     else{
         DataValue val = fifo.front();
-        fifo.erase(fifo.begin());
+        fifo.pop();
         return val;
     }
 }
 
 void CPU::simulate() {
+    STATS_ONLY(std::size_t before = registers.size();)
     for (int i = 0; i < frequency; ++i) {
         Instruction instr = program.compute();
         if (instr.opcode != NOP) {
-            double result = instr.compute();
+            STATS_ONLY(if (instr.opcode == DIV && Value::isZero(instr.right())) ++stats.divByZero;)
+            value_t result = instr.compute();
             registers.push(DataValue(result, true));  
         }
         else {
@@ -126,6 +117,15 @@ void CPU::simulate() {
             }
         }
     }
+    STATS_ONLY(
+        if (registers.size() == before) ++stats.stallCycles;
+        stats.sampleOccupancy(registers.size());
+    )
+}
+
+// Un CPU n'a pas d'entrée : n cycles = n simulate(), sans appel virtuel
+void CPU::simulate(std::uint64_t cycles) {
+    for (std::uint64_t i = 0; i < cycles; ++i) CPU::simulate();
 }
 
 void CPU::printInfo() const {
@@ -0,0 +1,15 @@
+#include "dispatch.h"
+#include <typeinfo>
+
+// Type exact uniquement : une sous-classe de BUS (ou autre) peut redéfinir read()
+SourceHandle& SourceHandle::operator=(ReadableComponent* c) {
+    ptr = c;
+    kind = Kind::VIRTUAL;
+    if (!c || !typedDispatch) return *this;
+
+    const std::type_info& type = typeid(*c);
+    if (type == typeid(CPU)) kind = Kind::CPU;
+    else if (type == typeid(BUS)) kind = Kind::BUS;
+    else if (type == typeid(Memory)) kind = Kind::MEMORY;
+    return *this;
+}
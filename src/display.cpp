@@ -1,4 +1,7 @@
 #include "display.h"
+#include "dispatch.h"
+#include "config.h"
+#include <algorithm>
 
 Display::Display(int rate)
     : refreshRate(rate)
@@ -17,7 +20,7 @@ void Display::setRefreshRate(int rate) {
 void Display::bindSource(const std::string& sourceLabel) {
     source = ReadableComponentRegistry::getComponentByLabel(sourceLabel);
     if (!source) {
-        std::cerr << "Source with label \"" << sourceLabel << "\" not found\n";
+        Log::error() << "Source with label \"" << sourceLabel << "\" not found";
     }
 }
 
@@ -25,6 +28,18 @@ std::string Display::getSourceLabel() const {
     return source ? source->getLabel() : "No source";
 }
 
+bool Display::setParam(const std::string& key, const std::string& value) {
+    if (key == "FORMAT") return parseValueFormat(value, format);
+    if (key != "REFRESH" && key != "PRECISION") return Component::setParam(key, value);
+    try {
+        int v = std::stoi(value);
+        if (key == "REFRESH") setRefreshRate(v);
+        else setPrecision(v);
+    }
+    catch (...) { return false; }
+    return true;
+}
+
 void Display::printInfo() const {
     std::cout << "DISPLAY info: "
               << " refreshRate=" << refreshRate
@@ -34,36 +49,104 @@ void Display::printInfo() const {
 }
 
 bool Display::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open " << filename << std::endl;
+    auto cfg = ConfigCache::getConfig(filename);
+    if (!cfg) {
+        Log::error() << "Error: Could not open " << filename;
         return false;
     }
 
-    std::string line, key, value;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-        std::istringstream iss(line);
-        if (std::getline(iss, key, ':') && std::getline(iss, value)) {
-            key = trim(key);
-            value = trim(value);
-
-            if (key == "TYPE") {
-                if (value != "DISPLAY") {
-                    std::cerr << "Error: TYPE must be 'DISPLAY', found '" << value << "' instead." << std::endl;
-                    return false;
-                }
-            } else if (key == "REFRESH") {
-                setRefreshRate(std::stoi(value));
-            } else if (key == "SOURCE") {
-                bindSource(value);
+    for (const auto& [key, value] : cfg->entries) {
+        if (key == "TYPE") {
+            if (value != "DISPLAY") {
+                Log::error() << "Error: TYPE must be 'DISPLAY', found '" << value << "' instead.";
+                return false;
             }
+        } else if (key == "REFRESH") {
+            setRefreshRate(std::stoi(value));
+        } else if (key == "FORMAT") {
+            if (!parseValueFormat(value, format)) {
+                Log::error() << "Error: FORMAT must be GENERAL, SHORTEST, FIXED or HEX, found '" << value << "' instead.";
+                return false;
+            }
+        } else if (key == "PRECISION") {
+            setPrecision(std::stoi(value));
+        } else if (key == "SOURCE") {
+            bindSource(value);
+        } else if (key == "CLOCK") {
+            parseClock(value);
         }
     }
 
     return true;
 }
 
+// Seuls les appels où callCounter atteint refreshRate produisent un affichage
+std::uint64_t Display::nextWakeup(std::uint64_t now) const {
+    if (!source) return NEVER;
+    if (refreshRate <= callCounter + 1) return now + 1;
+    return now + static_cast<std::uint64_t>(refreshRate - callCounter);
+}
+
+// Quantum : seuls les appels qui atteignent refreshRate passent par simulate()
+void Display::simulate(std::uint64_t cycles) {
+    if (!source) return;
+    while (cycles > 0) {
+        std::uint64_t untilRefresh = refreshRate > callCounter
+            ? static_cast<std::uint64_t>(refreshRate - callCounter) : 1;
+        if (cycles < untilRefresh) {
+            callCounter += static_cast<int>(cycles); // reste < refreshRate
+            return;
+        }
+        callCounter += static_cast<int>(untilRefresh - 1);
+        cycles -= untilRefresh;
+        Display::simulate();
+    }
+}
+
+// Jamais au-delà de refreshRate : un rafraîchissement atteint reste dû au prochain
+// simulate(), et le compteur ne déborde pas quel que soit n
+void Display::skipCycles(std::uint64_t n) {
+    if (!source) return;
+    std::uint64_t rate = refreshRate > 0 ? static_cast<std::uint64_t>(refreshRate) : 0;
+    std::uint64_t reached = static_cast<std::uint64_t>(callCounter) + n;
+    callCounter = static_cast<int>(std::min(reached, std::max(rate, static_cast<std::uint64_t>(callCounter))));
+}
+
+// Fast-forward : autant de rafraîchissements que de passages à refreshRate, mais un
+// seul vidage de la source suffit et rien n'est affiché
+void Display::fastForward(std::uint64_t cycles) {
+    if (!source) return;
+    std::uint64_t rate = refreshRate > 1 ? static_cast<std::uint64_t>(refreshRate) : 1;
+    std::uint64_t reached = static_cast<std::uint64_t>(callCounter) + cycles;
+    callCounter = static_cast<int>(reached % rate);
+    if (reached < rate) return;
+    drain();
+}
+
+// Vide la source dans values, par blocs
+std::size_t Display::drain() {
+    constexpr std::size_t CHUNK = 256;
+    values.clear();
+    for (;;) {
+        std::size_t size = values.size();
+        values.resize(size + CHUNK);
+        std::size_t n = source.readBatch(values.data() + size, CHUNK);
+        values.resize(size + n);
+        if (n < CHUNK) return values.size();
+    }
+}
+
+// Ligne complète formatée dans line, puis une seule écriture
+void Display::writeLine() {
+    line.assign("[DISPLAY] Source: ");
+    line += getSourceLabel();
+    line += " -> ";
+    for (value_t v : values) appendValue(line, v, format, precision);
+    line += '\n';
+    std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+    std::cout.flush();
+}
+
 void Display::simulate() {
     if (!source) return;
 
@@ -72,13 +155,14 @@ void Display::simulate() {
 
     callCounter = 0;
 
-    std::cout << "[DISPLAY] Source: " << getSourceLabel() << " -> ";
-
-    while (true) {
-        DataValue val = source->read();
-        if (!val.valid) break;
-        std::cout << val.value << " ";
+    std::size_t n = drain();
+    STATS_ONLY(
+        stats.consumed += n;
+        if (n == 0) ++stats.stallCycles;
+    )
+    if (output) {
+        output(*this, values.data(), n);
+        return;
     }
-
-    std::cout << std::endl;
+    writeLine();
 }
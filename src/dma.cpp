@@ -0,0 +1,78 @@
+#include "dma.h"
+#include "config.h"
+
+// ========================= Comportement =========================
+CoroutineComponent::Behavior Dma::behavior() {
+    std::vector<DataValue> pending;
+    pending.reserve(static_cast<std::size_t>(burst));
+    for (;;) {
+        DataValue first = co_await input();
+        if (!first.valid) {
+            co_await cycles(1); // source sans hasData() fiable : on réessaie au cycle suivant
+            continue;
+        }
+
+        pending.clear();
+        pending.push_back(first);
+        while (static_cast<int>(pending.size()) < burst && sourceHasData()) {
+            DataValue dv = take();
+            if (!dv.valid) break;
+            pending.push_back(dv);
+        }
+
+        co_await cycles(static_cast<std::uint64_t>(latency));
+
+        for (const DataValue& dv : pending) emit(dv);
+        ++transfers;
+    }
+}
+
+// ========================= Load from File =========================
+bool Dma::loadFromFile(const std::string& filename) {
+    auto cfg = ConfigCache::getConfig(filename);
+    if (!cfg) {
+        Log::error() << "Error: Could not open " << filename;
+        return false;
+    }
+
+    for (const auto& [key, value] : cfg->entries) {
+        if (key == "TYPE") {
+            if (value != "DMA") {
+                Log::error() << "Error: TYPE must be 'DMA', found '" << value << "' instead.";
+                return false;
+            }
+        } else if (key == "BURST") {
+            try { setBurst(std::stoi(value)); }
+            catch (...) { setBurst(1); }
+        } else if (key == "LATENCY") {
+            try { setLatency(std::stoi(value)); }
+            catch (...) { setLatency(1); }
+        } else if (!parseCommonKey(key, value)) {
+            Log::warning() << "Warning: Unknown key '" << key << "' in " << filename;
+        }
+    }
+    return true;
+}
+
+// Un transfert en cours garde sa latence, le burst suivant prend les nouvelles valeurs
+bool Dma::setParam(const std::string& key, const std::string& value) {
+    if (key != "BURST" && key != "LATENCY") return Component::setParam(key, value);
+    try {
+        if (key == "BURST") setBurst(std::stoi(value));
+        else setLatency(std::stoi(value));
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
+// ========================= Print Info =========================
+void Dma::printInfo() const {
+    std::cout << "DMA label=\"" << label
+              << "\" burst=" << burst
+              << " latency=" << latency
+              << " source=\"" << getSourceLabel() << "\""
+              << " transfers=" << transfers
+              << " queued=" << getOutputSize()
+              << std::endl;
+}
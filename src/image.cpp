@@ -0,0 +1,391 @@
+#include "platform.h"
+#include "image.h"
+#include "dma.h"
+#include "config.h"
+#include <cstring>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace image;
+
+// ======================================================================================
+//                         Construction de l'image (saveImage)
+// ======================================================================================
+
+namespace {
+
+struct ImageBuilder {
+    std::vector<ImageNode> nodes;
+    std::vector<ImageProgram> programs;
+    std::vector<ImageInstruction> instructions;
+    std::string strings;
+
+    // Pour les fixups : composant -> index de noeud, noeud -> source à résoudre
+    std::unordered_map<const ReadableComponent*, std::int32_t> indexOf;
+    std::vector<std::pair<std::size_t, ReadableComponent*>> pendingSources;
+
+    // Programmes dédupliqués sur leur contenu binaire
+    std::map<std::string, std::int32_t> programIndex;
+
+    std::size_t addNode(NodeKind kind, std::int32_t parent, const std::string& label, const Clock& clock) {
+        ImageNode node{};
+        node.clock_num = clock.num;
+        node.clock_den = clock.den;
+        node.clock_phase = clock.phase;
+        node.kind = kind;
+        node.parent = parent;
+        node.source = -1;
+        node.label_offset = static_cast<std::uint32_t>(strings.size());
+        node.label_size = static_cast<std::uint32_t>(label.size());
+        strings += label;
+        nodes.push_back(node);
+        return nodes.size() - 1;
+    }
+
+    std::int32_t addProgram(const Program& program) {
+        std::vector<ImageInstruction> code;
+        for (const auto& instr : program) {
+            ImageInstruction ii{};
+            ii.opcode = instr.opcode;
+            ii.operand_l = Value::toDouble(instr.left());
+            ii.operand_r = Value::toDouble(instr.right());
+            code.push_back(ii);
+        }
+        std::string key(reinterpret_cast<const char*>(code.data()), code.size() * sizeof(ImageInstruction));
+        auto it = programIndex.find(key);
+        if (it != programIndex.end()) return it->second;
+
+        ImageProgram p{static_cast<std::uint32_t>(instructions.size()), static_cast<std::uint32_t>(code.size())};
+        instructions.insert(instructions.end(), code.begin(), code.end());
+        programs.push_back(p);
+        std::int32_t idx = static_cast<std::int32_t>(programs.size() - 1);
+        programIndex.emplace(std::move(key), idx);
+        return idx;
+    }
+};
+
+template <typename T>
+void appendTable(std::string& out, const std::vector<T>& table) {
+    out.append(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(T));
+}
+
+void alignTo8(std::string& out) {
+    while (out.size() % 8 != 0) out.push_back('\0');
+}
+
+} // namespace
+
+bool Platform::encodeImage(std::string& out) {
+    ImageBuilder b;
+
+    // Parcours en pré-ordre, même ordre que simulate()
+    std::vector<std::pair<Platform*, std::int32_t>> stack{{this, -1}};
+    while (!stack.empty()) {
+        auto [p, parent] = stack.back();
+        stack.pop_back();
+
+        std::int32_t self = static_cast<std::int32_t>(b.addNode(NODE_PLATFORM, parent, p->getLabel(), p->getClock()));
+        b.indexOf[p] = self;
+        if (p->getOutput()) b.pendingSources.emplace_back(self, p->getOutput());
+
+        for (CPU* cpu : p->cpus) {
+            std::size_t i = b.addNode(NODE_CPU, self, cpu->getLabel(), cpu->getClock());
+            b.indexOf[cpu] = static_cast<std::int32_t>(i);
+            b.nodes[i].p0 = cpu->getFrequency();
+            b.nodes[i].p1 = cpu->getNCores();
+            b.nodes[i].p2 = cpu->getProgram().empty() ? -1 : b.addProgram(cpu->getProgram());
+        }
+        for (Memory* mem : p->memories) {
+            std::size_t i = b.addNode(NODE_MEMORY, self, mem->getLabel(), mem->getClock());
+            b.indexOf[mem] = static_cast<std::int32_t>(i);
+            b.nodes[i].p0 = static_cast<std::int64_t>(mem->getSize());
+            b.nodes[i].p1 = mem->getAccessTime();
+            b.pendingSources.emplace_back(i, mem->getSource());
+        }
+        for (BUS* bus : p->buses) {
+            std::size_t i = b.addNode(NODE_BUS, self, bus->getLabel(), bus->getClock());
+            b.indexOf[bus] = static_cast<std::int32_t>(i);
+            b.nodes[i].p0 = bus->getWidth();
+            b.pendingSources.emplace_back(i, bus->getSource());
+        }
+        for (CoroutineComponent* co : p->coroutines) {
+            // Seul type en coroutine pour l'instant : DMA
+            Dma* dma = static_cast<Dma*>(co);
+            std::size_t i = b.addNode(NODE_DMA, self, dma->getLabel(), dma->getClock());
+            b.indexOf[dma] = static_cast<std::int32_t>(i);
+            b.nodes[i].p0 = dma->getBurst();
+            b.nodes[i].p1 = dma->getLatency();
+            b.pendingSources.emplace_back(i, dma->getSource());
+        }
+        for (Display* display : p->displays) {
+            std::size_t i = b.addNode(NODE_DISPLAY, self, "", display->getClock());
+            b.nodes[i].p0 = display->getRefreshRate();
+            b.nodes[i].p1 = static_cast<std::int64_t>(display->getFormat());
+            b.nodes[i].p2 = display->getPrecision();
+            b.pendingSources.emplace_back(i, display->getSource());
+        }
+        // Empilées à l'envers pour être dépilées dans l'ordre
+        for (auto it = p->platforms.rbegin(); it != p->platforms.rend(); ++it) {
+            stack.emplace_back(*it, self);
+        }
+    }
+
+    // Liens : pointeur -> index de noeud
+    for (auto& [node, src] : b.pendingSources) {
+        if (!src) continue;
+        auto it = b.indexOf.find(src);
+        if (it == b.indexOf.end()) {
+            Log::warning() << "Warning: source \"" << src->getLabel()
+                           << "\" is outside the platform, link dropped from image";
+            continue;
+        }
+        b.nodes[node].source = it->second;
+    }
+
+    ImageHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.n_nodes = static_cast<std::uint32_t>(b.nodes.size());
+    header.n_programs = static_cast<std::uint32_t>(b.programs.size());
+    header.n_instructions = static_cast<std::uint32_t>(b.instructions.size());
+
+    out.assign(sizeof(ImageHeader), '\0');
+    alignTo8(out);
+    header.nodes_offset = out.size();
+    appendTable(out, b.nodes);
+    alignTo8(out);
+    header.programs_offset = out.size();
+    appendTable(out, b.programs);
+    alignTo8(out);
+    header.instructions_offset = out.size();
+    appendTable(out, b.instructions);
+    header.strings_offset = out.size();
+    header.strings_size = b.strings.size();
+    out += b.strings;
+    std::memcpy(&out[0], &header, sizeof(header));
+    return true;
+}
+
+bool Platform::saveImage(const std::string& filename) {
+    std::string out;
+    if (!encodeImage(out)) return false;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        Log::error() << "Error: Could not open " << filename;
+        return false;
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+// ======================================================================================
+//                         Chargement de l'image (loadImage)
+// ======================================================================================
+
+bool Platform::isImageFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    if (!file.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool Platform::loadImage(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        Log::error() << "Error: Could not open " << filename;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(ImageHeader)) {
+        Log::error() << "Error: " << filename << " is not a valid platform image";
+        close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        Log::error() << "Error: Could not map " << filename;
+        return false;
+    }
+    bool ok = decodeImage(static_cast<const char*>(map), size, filename);
+    munmap(map, size);
+    return ok;
+}
+
+bool Platform::decodeImage(const char* base, std::size_t size, const std::string& filename) {
+    if (size < sizeof(ImageHeader)) {
+        Log::error() << "Error: " << filename << " is not a valid platform image";
+        return false;
+    }
+
+    ImageHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    bool ok = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+           && header.version == VERSION
+           && header.n_nodes > 0
+           && header.nodes_offset + std::uint64_t(header.n_nodes) * sizeof(ImageNode) <= size
+           && header.programs_offset + std::uint64_t(header.n_programs) * sizeof(ImageProgram) <= size
+           && header.instructions_offset + std::uint64_t(header.n_instructions) * sizeof(ImageInstruction) <= size
+           && header.strings_offset + header.strings_size <= size;
+    if (!ok) {
+        Log::error() << "Error: " << filename << " is not a valid platform image";
+        return false;
+    }
+
+    const ImageNode* nodes = reinterpret_cast<const ImageNode*>(base + header.nodes_offset);
+    const ImageProgram* programs = reinterpret_cast<const ImageProgram*>(base + header.programs_offset);
+    const ImageInstruction* instructions = reinterpret_cast<const ImageInstruction*>(base + header.instructions_offset);
+    const char* strings = base + header.strings_offset;
+
+    auto labelOf = [&](const ImageNode& n) {
+        if (std::uint64_t(n.label_offset) + n.label_size > header.strings_size) return std::string();
+        return std::string(strings + n.label_offset, n.label_size);
+    };
+
+    // Le noeud 0 est la racine : seule plateforme sans parent
+    if (nodes[0].kind != NODE_PLATFORM || nodes[0].parent >= 0) {
+        Log::error() << "Error: " << filename << " is corrupted";
+        return false;
+    }
+    auto inRange = [](std::int64_t v, std::int64_t lo) { return v >= lo && v <= MAX_PARAM; };
+
+    // La racine enregistre toute sa hiérarchie dans sa propre registry
+    std::optional<ReadableComponentRegistry::Scope> scope;
+    if (arena == &ownArena) scope.emplace(registry);
+
+    // Passe 1 : création des composants, noeud par noeud
+    std::vector<Platform*> platformOf(header.n_nodes, nullptr);
+    std::vector<ReadableComponent*> readable(header.n_nodes, nullptr);
+    std::vector<BUS*> busOf(header.n_nodes, nullptr);
+    std::vector<Memory*> memoryOf(header.n_nodes, nullptr);
+    std::vector<Display*> displayOf(header.n_nodes, nullptr);
+    std::vector<Dma*> dmaOf(header.n_nodes, nullptr);
+    std::vector<std::shared_ptr<const InstructionList>> decoded(header.n_programs);
+
+    for (std::uint32_t i = 0; i < header.n_nodes && ok; ++i) {
+        const ImageNode& n = nodes[i];
+        Platform* parent = (n.parent >= 0 && static_cast<std::uint32_t>(n.parent) < i) ? platformOf[n.parent] : nullptr;
+        if (i > 0 && !parent) { ok = false; break; }
+
+        switch (n.kind) {
+            case NODE_PLATFORM: {
+                if (i == 0) {
+                    setLabel(labelOf(n));
+                    platformOf[i] = this;
+                } else {
+                    Platform* sub = arena->make<Platform>(labelOf(n));
+                    sub->arena = arena;
+                    platformOf[i] = sub;
+                    parent->platforms.push_back(sub);
+                }
+                readable[i] = platformOf[i];
+                break;
+            }
+            case NODE_CPU: {
+                // FREQUENCY 0 : CPU arrêté
+                if (!inRange(n.p0, 0) || !inRange(n.p1, 1)) { ok = false; break; }
+                CPU* cpu = arena->make<CPU>(static_cast<int>(n.p0), static_cast<int>(n.p1), labelOf(n));
+                if (n.p2 >= 0 && static_cast<std::uint64_t>(n.p2) < header.n_programs) {
+                    // Décodé une fois par programme de l'image, puis partagé (ConfigCache)
+                    std::shared_ptr<const InstructionList>& shared = decoded[n.p2];
+                    if (!shared) {
+                        const ImageProgram& p = programs[n.p2];
+                        if (std::uint64_t(p.first) + p.count > header.n_instructions) { ok = false; break; }
+                        InstructionList code;
+                        code.reserve(p.count);
+                        for (std::uint32_t k = 0; k < p.count; ++k) {
+                            const ImageInstruction& ii = instructions[p.first + k];
+                            code.emplace_back(static_cast<OPCODE>(ii.opcode), Value::fromDouble(ii.operand_l),
+                                              Value::fromDouble(ii.operand_r));
+                        }
+                        shared = ConfigCache::internProgram(std::move(code));
+                    }
+                    cpu->getProgram().assign(shared);
+                }
+                readable[i] = cpu;
+                registry.registerComponent(cpu);
+                parent->cpus.push_back(cpu);
+                break;
+            }
+            case NODE_MEMORY: {
+                if (!inRange(n.p0, 1) || !inRange(n.p1, 1)) { ok = false; break; }
+                Memory* mem = arena->make<Memory>(labelOf(n));
+                mem->setSize(static_cast<std::size_t>(n.p0));
+                mem->setAccessTime(static_cast<int>(n.p1));
+                readable[i] = memoryOf[i] = mem;
+                registry.registerComponent(mem);
+                parent->memories.push_back(mem);
+                break;
+            }
+            case NODE_BUS: {
+                if (!inRange(n.p0, 1)) { ok = false; break; }
+                BUS* bus = arena->make<BUS>(labelOf(n));
+                bus->setWidth(static_cast<int>(n.p0));
+                readable[i] = busOf[i] = bus;
+                registry.registerComponent(bus);
+                parent->buses.push_back(bus);
+                break;
+            }
+            case NODE_DMA: {
+                if (!inRange(n.p0, 0) || !inRange(n.p1, 0)) { ok = false; break; }
+                Dma* dma = arena->make<Dma>(labelOf(n));
+                dma->setBurst(static_cast<int>(n.p0));
+                dma->setLatency(static_cast<int>(n.p1));
+                readable[i] = dmaOf[i] = dma;
+                registry.registerComponent(dma);
+                parent->coroutines.push_back(dma);
+                break;
+            }
+            case NODE_DISPLAY: {
+                if (!inRange(n.p0, 0) || !inRange(n.p2, -1)) { ok = false; break; }
+                if (n.p1 < 0 || n.p1 > static_cast<std::int64_t>(ValueFormat::HEX)) { ok = false; break; }
+                Display* display = arena->make<Display>(static_cast<int>(n.p0));
+                display->setFormat(static_cast<ValueFormat>(n.p1));
+                display->setPrecision(static_cast<int>(n.p2));
+                displayOf[i] = display;
+                parent->displays.push_back(display);
+                break;
+            }
+            default:
+                ok = false;
+        }
+
+        if (ok) {
+            Component* c = readable[i] ? static_cast<Component*>(readable[i]) : displayOf[i];
+            if (n.clock_num == 0 || n.clock_den == 0 || n.clock_phase >= n.clock_den) { ok = false; break; }
+            c->setClock(Clock{n.clock_num, n.clock_den, n.clock_phase});
+        }
+    }
+
+    // Passe 2 : fixups des pointeurs source
+    for (std::uint32_t i = 0; i < header.n_nodes && ok; ++i) {
+        std::int32_t s = nodes[i].source;
+        if (s < 0) continue;
+        if (static_cast<std::uint32_t>(s) >= header.n_nodes || !readable[s]) { ok = false; break; }
+        if (platformOf[i]) {
+            // Port OUTPUT : composant direct de la plateforme
+            if (nodes[s].parent != static_cast<std::int32_t>(i)) { ok = false; break; }
+            platformOf[i]->bindOutput(readable[s]);
+            if (i > 0) registry.registerComponent(platformOf[i]);
+        }
+        else if (busOf[i]) busOf[i]->bindSource(readable[s]);
+        else if (memoryOf[i]) memoryOf[i]->bindSource(readable[s]);
+        else if (dmaOf[i]) dmaOf[i]->bindSource(readable[s]);
+        else if (displayOf[i]) displayOf[i]->bindSource(readable[s]);
+    }
+
+    for (Platform* p : platformOf) if (p) p->updateClocked();
+    if (!ok) {
+        Log::error() << "Error: " << filename << " is corrupted";
+    } else if (arena == &ownArena) {
+        compactState();
+    }
+    return ok;
+}
@@ -0,0 +1,125 @@
+#include "livestats.h"
+#include "platform.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// ========================= Constructor / Destructor =========================
+LiveStats::LiveStats(Platform& platform, const std::string& shmName, std::uint64_t every, std::uint64_t totalCycles)
+    : name(shmName), interval(every ? every : 1)
+{
+    platform.forEachComponent([this](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<T, CPU>) sources.push_back({Source::Kind::CPU, &c});
+        else if constexpr (std::is_same_v<T, BUS>) sources.push_back({Source::Kind::BUS, &c});
+        else if constexpr (std::is_same_v<T, Memory>) sources.push_back({Source::Kind::MEMORY, &c});
+        else if constexpr (std::is_same_v<T, Display>) sources.push_back({Source::Kind::DISPLAY, &c});
+    });
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) {
+        Log::error() << "Error: Could not create shared memory segment " << name;
+        return;
+    }
+    segmentSize = live::Segment::bytesFor(static_cast<std::uint32_t>(sources.size()));
+    if (ftruncate(fd, static_cast<off_t>(segmentSize)) != 0) {
+        Log::error() << "Error: Could not size shared memory segment " << name;
+        close(fd);
+        shm_unlink(name.c_str());
+        return;
+    }
+    void* map = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        Log::error() << "Error: Could not map shared memory segment " << name;
+        shm_unlink(name.c_str());
+        return;
+    }
+
+    segment = static_cast<live::Segment*>(map);
+    segment->version = live::VERSION;
+    segment->n_entries = static_cast<std::uint32_t>(sources.size());
+    segment->pid = static_cast<std::uint64_t>(getpid());
+    new (&segment->seq) std::atomic<std::uint64_t>(0);
+    new (&segment->cycle) std::atomic<std::uint64_t>(0);
+    new (&segment->cyclesPerSecBits) std::atomic<std::uint64_t>(0);
+    new (&segment->totalCycles) std::atomic<std::uint64_t>(totalCycles);
+
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        live::Entry& e = segment->entries[i];
+        const char* type = "";
+        std::string label;
+        switch (sources[i].kind) {
+            case Source::Kind::CPU: type = "CPU"; label = static_cast<const CPU*>(sources[i].component)->getLabel(); break;
+            case Source::Kind::BUS: type = "BUS"; label = static_cast<const BUS*>(sources[i].component)->getLabel(); break;
+            case Source::Kind::MEMORY: type = "MEMORY"; label = static_cast<const Memory*>(sources[i].component)->getLabel(); break;
+            case Source::Kind::DISPLAY:
+                type = "DISPLAY";
+                label = "<- " + static_cast<const Display*>(sources[i].component)->getSourceLabel();
+                break;
+        }
+        std::memset(e.type, 0, sizeof(e.type));
+        std::memset(e.label, 0, sizeof(e.label));
+        std::memcpy(e.type, type, std::min(std::strlen(type), sizeof(e.type) - 1));
+        std::memcpy(e.label, label.data(), std::min(label.size(), sizeof(e.label) - 1));
+        new (&e.produced) std::atomic<std::uint64_t>(0);
+        new (&e.consumed) std::atomic<std::uint64_t>(0);
+        new (&e.occupancy) std::atomic<std::uint64_t>(0);
+    }
+
+    // Le magic est écrit en dernier : un lecteur ne voit jamais un segment à moitié initialisé
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(segment->magic, live::MAGIC, sizeof(live::MAGIC));
+
+    lastTime = std::chrono::steady_clock::now();
+}
+
+LiveStats::~LiveStats() {
+    if (!segment) return;
+    munmap(segment, segmentSize);
+    shm_unlink(name.c_str());
+}
+
+// ========================= Update (seqlock) =========================
+void LiveStats::update(std::uint64_t cycle) {
+    if (!segment) return;
+
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - lastTime).count();
+    double rate = elapsed > 0.0 ? static_cast<double>(cycle - lastCycle) / elapsed : 0.0;
+    lastTime = now;
+    lastCycle = cycle;
+    std::uint64_t rateBits;
+    std::memcpy(&rateBits, &rate, sizeof(rate));
+
+    std::uint64_t seq = segment->seq.load(std::memory_order_relaxed);
+    segment->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    segment->cycle.store(cycle, std::memory_order_relaxed);
+    segment->cyclesPerSecBits.store(rateBits, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        live::Entry& e = segment->entries[i];
+        std::uint64_t occupancy = 0;
+        switch (sources[i].kind) {
+            case Source::Kind::CPU: occupancy = static_cast<const CPU*>(sources[i].component)->getRegisterDepth(); break;
+            case Source::Kind::BUS: {
+                const BUS* bus = static_cast<const BUS*>(sources[i].component);
+                occupancy = bus->getReadySize() + bus->getPendingSize();
+                break;
+            }
+            case Source::Kind::MEMORY: occupancy = static_cast<const Memory*>(sources[i].component)->getCount(); break;
+            case Source::Kind::DISPLAY: break;
+        }
+        e.occupancy.store(occupancy, std::memory_order_relaxed);
+#ifdef PROJC_STATS
+        const ComponentStats& s = sources[i].component->getStats();
+        e.produced.store(s.produced, std::memory_order_relaxed);
+        e.consumed.store(s.consumed, std::memory_order_relaxed);
+#endif
+    }
+
+    segment->seq.store(seq + 2, std::memory_order_release);
+}
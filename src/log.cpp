@@ -0,0 +1,13 @@
+#include "log.h"
+#include <iostream>
+
+thread_local const Log::Sink* Log::current = nullptr;
+
+void Log::write(LogLevel level, const std::string& message) {
+    if (current) {
+        if (*current) (*current)(level, message);
+        return;
+    }
+    std::ostream& os = (level == LogLevel::INFO) ? std::cout : std::cerr;
+    os << message << std::endl;
+}
@@ -1,11 +1,29 @@
 #include "mem.h"
+#include "dispatch.h"
 #include "lib.h"
+#include "config.h"
 #include <algorithm>
 
 Memory::Memory(const std::string& lbl)
     : ReadableComponent(lbl)
 {
-    buffer.resize(capacity);
+    storage.resize(capacity);
+    buffer = storage.data();
+}
+
+Memory::Memory(const Memory& other)
+    : ReadableComponent(other),
+      capacity(other.capacity),
+      accessTime(other.accessTime),
+      cycleCounter(other.cycleCounter),
+      source(other.source),
+      sourceLabelStored(other.sourceLabelStored),
+      storage(other.buffer, other.buffer + other.capacity),
+      head(other.head),
+      tail(other.tail),
+      count(other.count)
+{
+    buffer = storage.data();
 }
 
 Memory::~Memory() = default;
@@ -18,6 +36,7 @@ void Memory::pushValue(const DataValue& dv) {
         ++count;
     } else {
         head = tail;
+        STATS_ONLY(++stats.dropped;)
     }
 }
 
@@ -29,13 +48,21 @@ void Memory::setSize(std::size_t s) {
         newbuf[i] = buffer[idx];
         idx = (idx + 1) % capacity;
     }
-    buffer.swap(newbuf);
+    storage.swap(newbuf);
+    buffer = storage.data();
     capacity = s;
     head = 0;
     tail = std::min(count, s) % capacity;
     count = std::min(count, s);
 }
 
+void Memory::placeIn(Arena& arena) {
+    DataValue* placed = arena.allocateArray<DataValue>(capacity);
+    std::copy(buffer, buffer + capacity, placed);
+    buffer = placed;
+    std::vector<DataValue>().swap(storage);
+}
+
 void Memory::setAccessTime(int a) {
     if (a <= 0) a = 1;
     accessTime = a;
@@ -43,15 +70,28 @@ void Memory::setAccessTime(int a) {
 
 void Memory::bindSource(const std::string& lbl) {
     if (lbl == getLabel()) {
-        std::cerr << "Error: BUS '" << label << "' cannot bind to itself as source.\n";
+        Log::error() << "Error: BUS '" << label << "' cannot bind to itself as source.";
         source = nullptr;
         return;
     }
 
     source = ReadableComponentRegistry::getComponentByLabel(lbl);
     if (!source) {
-        std::cerr << "Source with label \"" << lbl << "\" not found\n";
+        Log::error() << "Source with label \"" << lbl << "\" not found";
+    }
+}
+
+void Memory::bindSource(ReadableComponent* src) {
+    source = src;
+    sourceLabelStored = src ? src->getLabel() : "";
+}
+
+// Source résolue (la liaison par label peut être différée jusqu'au premier simulate())
+ReadableComponent* Memory::getSource() {
+    if (!source && !sourceLabelStored.empty()) {
+        source = ReadableComponentRegistry::getComponentByLabel(sourceLabelStored);
     }
+    return source.get();
 }
 
 std::string Memory::getSourceLabel() const {
@@ -59,66 +99,109 @@ std::string Memory::getSourceLabel() const {
 }
 
 bool Memory::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "[MEM] Error : could not load " << filename << "\n";
+    auto cfg = ConfigCache::getConfig(filename);
+    if (!cfg) {
+        Log::error() << "[MEM] Error : could not load " << filename;
         return false;
     }
 
-    std::string line;
-    std::string key, value, type;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-        std::istringstream iss(line);
-        if (std::getline(iss, key, ':') && std::getline(iss, value)) {
-            key = trim(key);
-            value = trim(value);
-            if (key == "TYPE") {
-                type = value;
-                if (value != "MEMORY") {
-                    std::cerr << "Error: TYPE must be 'MEM', found '" << type << "' instead." << std::endl;
-                    return false;
-                }
-            } else if (key == "LABEL") {
-                setLabel(value);
-            } else if (key == "SIZE") {
-                try { setSize(static_cast<std::size_t>(std::stoul(value))); }
-                catch (...) { setSize(1); }
-            } else if (key == "ACCESS") {
-                try { setAccessTime(std::stoi(value)); }
-                catch (...) { setAccessTime(1); }
-            } else if (key == "SOURCE") {
-                sourceLabelStored = value;
-                bindSource(value);
+    for (const auto& [key, value] : cfg->entries) {
+        if (key == "TYPE") {
+            if (value != "MEMORY") {
+                Log::error() << "Error: TYPE must be 'MEM', found '" << value << "' instead.";
+                return false;
             }
+        } else if (key == "LABEL") {
+            setLabel(value);
+        } else if (key == "SIZE") {
+            try { setSize(static_cast<std::size_t>(std::stoul(value))); }
+            catch (...) { setSize(1); }
+        } else if (key == "ACCESS") {
+            try { setAccessTime(std::stoi(value)); }
+            catch (...) { setAccessTime(1); }
+        } else if (key == "SOURCE") {
+            sourceLabelStored = value;
+            bindSource(value);
+        } else if (key == "CLOCK") {
+            parseClock(value);
         }
     }
     return true;
 }
 
+// SIZE garde les données les plus anciennes qui tiennent, ACCESS repart du cycle courant
+bool Memory::setParam(const std::string& key, const std::string& value) {
+    if (key != "SIZE" && key != "ACCESS") return Component::setParam(key, value);
+    try {
+        if (key == "SIZE") setSize(static_cast<std::size_t>(std::stoul(value)));
+        else setAccessTime(std::stoi(value));
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
 void Memory::simulate() {
     ++cycleCounter;
     if (!source && !sourceLabelStored.empty()) {
         source = ReadableComponentRegistry::getComponentByLabel(sourceLabelStored);
     }
 
-    if (accessTime <= 1 || (cycleCounter % accessTime) == 0) {
-        if (!source) return;
-        for (;;) {
-            DataValue dv = source->read();
-            if (!dv.valid) break;
-            pushValue(dv);
+    if (accessTime <= 1 || cycleCounter % static_cast<std::uint64_t>(accessTime) == 0) {
+        if (source) {
+            STATS_ONLY(std::uint64_t before = stats.consumed;)
+            for (;;) {
+                DataValue dv = source.read();
+                if (!dv.valid) break;
+                pushValue(dv);
+                STATS_ONLY(++stats.consumed;)
+            }
+            STATS_ONLY(if (stats.consumed == before) ++stats.stallCycles;)
         }
     }
+    STATS_ONLY(stats.sampleOccupancy(count);)
+}
+
+// Quantum : seuls les créneaux d'accès font un simulate(), les cycles entre deux créneaux
+// se résument à l'avance du compteur
+void Memory::simulate(std::uint64_t cycles) {
+    std::uint64_t a = static_cast<std::uint64_t>(accessTime);
+    while (cycles > 0) {
+        std::uint64_t untilSlot = a <= 1 ? 1 : a - cycleCounter % a;
+        std::uint64_t idle = std::min(cycles, untilSlot - 1);
+        cycleCounter += idle;
+        cycles -= idle;
+        STATS_ONLY(stats.sampleOccupancy(count, idle);)
+        if (cycles == 0) return;
+        Memory::simulate();
+        --cycles;
+    }
+}
+
+// ========================= Fast-forward =========================
+void Memory::fastForward(std::uint64_t cycles) {
+    if (!source && !sourceLabelStored.empty()) {
+        source = ReadableComponentRegistry::getComponentByLabel(sourceLabelStored);
+    }
+    std::uint64_t a = static_cast<std::uint64_t>(accessTime);
+    std::uint64_t phase = cycleCounter % a;
+    cycleCounter = (phase + cycles) % a;
+    if (!source || phase + cycles < a) return;
+    for (;;) {
+        DataValue dv = source.read();
+        if (!dv.valid) break;
+        pushValue(dv);
+    }
 }
 
-// ========================= Read =========================
-DataValue Memory::read() {
-    if (count == 0) return DataValue{0.0, false};
-    DataValue dv = buffer[head];
-    head = (head + 1) % capacity;
-    count--;
-    return dv;
+// ========================= Idle skipping =========================
+// Rien à faire entre deux créneaux d'accès, ni sur un créneau si la source est vide
+std::uint64_t Memory::nextWakeup(std::uint64_t now) const {
+    if (!source) return sourceLabelStored.empty() ? NEVER : now + 1;
+    if (!source.hasData()) return NEVER;
+    if (accessTime <= 1) return now + 1;
+    std::uint64_t a = static_cast<std::uint64_t>(accessTime);
+    return now + (a - cycleCounter % a);
 }
 
 // ========================= Print Info =========================
@@ -0,0 +1,328 @@
+#include "partition.h"
+#include "platform.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <new>
+#include <numeric>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <unordered_map>
+
+// ========================= Segment partagé =========================
+namespace {
+
+struct Slot {
+    std::uint64_t cycle;
+    value_t value;
+};
+
+// En-tête d'un canal, suivi de capacity Slot ; indices sur des lignes de cache distinctes
+struct Channel {
+    alignas(64) std::atomic<std::uint64_t> head; // prochain slot à lire (consommateur)
+    alignas(64) std::atomic<std::uint64_t> tail; // prochain slot à écrire (producteur)
+    alignas(64) std::atomic<std::uint64_t> done; // cycles terminés par le producteur
+
+    Slot* slots() { return reinterpret_cast<Slot*>(this + 1); }
+};
+
+struct Control {
+    alignas(64) std::atomic<std::uint32_t> failed;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "canaux inter-processus sans verrou");
+
+constexpr std::uint32_t NO_CHANNEL = UINT32_MAX;
+
+// Attente active courte, puis on rend la main (plus de partitions que de coeurs)
+template <typename Cond>
+bool waitFor(Control* control, Cond cond) {
+    for (unsigned spin = 0; !cond(); ++spin) {
+        if (control->failed.load(std::memory_order_relaxed)) return false;
+        if (spin >= 64) sched_yield();
+    }
+    return true;
+}
+
+// std::cout d'une partition redirigé vers son fichier de sortie (DISPLAY, printInfo, Log)
+class FileBuffer : public std::streambuf {
+public:
+    explicit FileBuffer(std::FILE* f) : file(f) {}
+
+protected:
+    int overflow(int c) override { return c == EOF ? 0 : std::fputc(c, file); }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        return static_cast<std::streamsize>(std::fwrite(s, 1, static_cast<std::size_t>(n), file));
+    }
+    int sync() override { return std::fflush(file); }
+
+private:
+    std::FILE* file;
+};
+
+std::size_t findRoot(std::vector<std::size_t>& parent, std::size_t i) {
+    while (parent[i] != i) i = parent[i] = parent[parent[i]];
+    return i;
+}
+
+} // namespace
+
+// ========================= Constructor / Destructor =========================
+PartitionedRun::PartitionedRun(Platform& platform, unsigned requested) {
+    // Unités : 0 pour les composants directs de la racine, i + 1 pour la sous-plateforme i
+    std::unordered_map<const Component*, std::size_t> unitOf;
+    const auto& subs = platform.getSubplatforms();
+    for (std::size_t i = 0; i < subs.size(); ++i) {
+        subs[i]->forEachComponent([&](auto& c) { unitOf[&c] = i + 1; });
+    }
+    const std::size_t units = subs.size() + 1;
+
+    // Composants feuilles dans l'ordre de simulate(), avec leur source
+    struct Leaf {
+        Component* component;
+        BUS* bus;
+        ReadableComponent* source;
+        std::size_t unit;
+        ClockChain clock;
+    };
+    std::vector<Leaf> leaves;
+    std::unordered_map<const ReadableComponent*, std::size_t> leafOf;
+    platform.forEachComponentClock([&](auto& c, const ClockChain& chain) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (!std::is_same_v<T, Platform>) {
+            Leaf leaf{&c, nullptr, nullptr, 0, chain};
+            auto it = unitOf.find(&c);
+            if (it != unitOf.end()) leaf.unit = it->second;
+            if constexpr (std::is_same_v<T, BUS>) leaf.bus = &c;
+            if constexpr (!std::is_same_v<T, CPU>) {
+                if (ReadableComponent* src = c.getSource()) leaf.source = src->producer();
+            }
+            if constexpr (std::is_base_of_v<ReadableComponent, T>) leafOf[&c] = leaves.size();
+            leaves.push_back(leaf);
+        }
+    });
+
+    // Un lien qui n'est pas un BUS ne peut pas être coupé : ses deux unités sont fusionnées
+    std::vector<std::size_t> parent(units);
+    std::iota(parent.begin(), parent.end(), 0);
+    std::vector<std::size_t> sourceLeaf(leaves.size(), SIZE_MAX);
+    for (std::size_t i = 0; i < leaves.size(); ++i) {
+        auto it = leaves[i].source ? leafOf.find(leaves[i].source) : leafOf.end();
+        if (it == leafOf.end()) continue; // pas de source, ou hors de la plateforme
+        sourceLeaf[i] = it->second;
+        if (!leaves[i].bus) {
+            parent[findRoot(parent, leaves[i].unit)] = findRoot(parent, leaves[it->second].unit);
+        }
+    }
+
+    // Groupes répartis du plus gros au plus petit sur la partition la moins chargée
+    std::vector<std::size_t> groupSize(units, 0);
+    for (const Leaf& leaf : leaves) ++groupSize[findRoot(parent, leaf.unit)];
+    std::vector<std::size_t> groups;
+    for (std::size_t u = 0; u < units; ++u) {
+        if (findRoot(parent, u) == u && groupSize[u] > 0) groups.push_back(u);
+    }
+    std::stable_sort(groups.begin(), groups.end(),
+                     [&](std::size_t a, std::size_t b) { return groupSize[a] > groupSize[b]; });
+
+    partitions = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(requested, groups.size())));
+    if (partitions < requested) {
+        Log::warning() << "Warning: only " << partitions << " independent group(s) of components, "
+                       << "using " << partitions << " partition(s)";
+    }
+    componentsOf.assign(partitions, 0);
+    std::vector<unsigned> partitionOfGroup(units, 0);
+    for (std::size_t g : groups) {
+        unsigned k = static_cast<unsigned>(std::min_element(componentsOf.begin(), componentsOf.end()) - componentsOf.begin());
+        partitionOfGroup[g] = k;
+        componentsOf[k] += groupSize[g];
+    }
+    auto partitionOf = [&](std::size_t leaf) { return partitionOfGroup[findRoot(parent, leaves[leaf].unit)]; };
+
+    // Actions de chaque partition, canaux pour les BUS coupés
+    steps.assign(partitions, {});
+    outbound.assign(partitions, {});
+    std::size_t offset = (sizeof(Control) + 63) / 64 * 64;
+    for (std::size_t i = 0; i < leaves.size(); ++i) {
+        unsigned k = partitionOf(i);
+        if (leaves[i].bus && sourceLeaf[i] != SIZE_MAX && partitionOf(sourceLeaf[i]) != k) {
+            unsigned producer = partitionOf(sourceLeaf[i]);
+            std::size_t width = static_cast<std::size_t>(std::max(1, leaves[i].bus->getWidth()));
+            std::size_t capacity = 256;
+            while (capacity < 4 * width) capacity *= 2;
+
+            std::uint32_t ch = static_cast<std::uint32_t>(channels.size());
+            channels.push_back({leaves[i].bus, producer, k, offset, capacity});
+            offset += sizeof(Channel) + capacity * sizeof(Slot);
+            offset = (offset + 63) / 64 * 64;
+
+            steps[producer].push_back({Step::Kind::FETCH, leaves[i].component, leaves[i].bus, ch, leaves[i].clock});
+            steps[k].push_back({Step::Kind::DELIVER, leaves[i].component, leaves[i].bus, ch, leaves[i].clock});
+            outbound[producer].push_back(ch);
+        } else {
+            steps[k].push_back({Step::Kind::SIMULATE, leaves[i].component, nullptr, NO_CHANNEL, leaves[i].clock});
+        }
+    }
+    segmentSize = offset;
+}
+
+PartitionedRun::~PartitionedRun() {
+    if (segment) munmap(segment, segmentSize);
+}
+
+// ========================= Plan =========================
+void PartitionedRun::printPlan(std::ostream& os) const {
+    os << "Partitions: " << partitions << ", cut buses: " << channels.size() << std::endl;
+    for (unsigned k = 0; k < partitions; ++k) {
+        os << "  partition " << k << ": " << componentsOf[k] << " components" << std::endl;
+    }
+    for (const ChannelInfo& ch : channels) {
+        os << "  BUS \"" << ch.bus->getLabel() << "\": source in partition " << ch.producer
+           << " -> partition " << ch.consumer << " (ring of " << ch.capacity << ")" << std::endl;
+    }
+}
+
+// ========================= Simulation d'une partition =========================
+void PartitionedRun::runPartition(unsigned k, std::uint64_t cycles) {
+    char* base = static_cast<char*>(segment);
+    Control* control = reinterpret_cast<Control*>(base);
+    auto channelAt = [&](std::uint32_t ch) { return reinterpret_cast<Channel*>(base + channels[ch].offset); };
+
+    // Au plus width valeurs par BUS et par cycle, dans un sens comme dans l'autre
+    int maxWidth = 1;
+    for (const ChannelInfo& ch : channels) maxWidth = std::max(maxWidth, ch.bus->getWidth());
+    std::vector<DataValue> scratch(static_cast<std::size_t>(maxWidth));
+
+    const std::vector<Step>& mine = steps[k];
+    for (std::uint64_t c = 0; c < cycles; ++c) {
+        for (const Step& step : mine) {
+            if (!step.clock.isBase() && !step.clock.edgesAt(c)) continue;
+            switch (step.kind) {
+                case Step::Kind::SIMULATE:
+                    step.component->simulate();
+                    break;
+
+                case Step::Kind::FETCH: {
+                    Channel* ch = channelAt(step.channel);
+                    const std::size_t capacity = channels[step.channel].capacity;
+                    std::size_t n = step.bus->fetch(scratch.data());
+                    std::uint64_t tail = ch->tail.load(std::memory_order_relaxed);
+                    if (!waitFor(control, [&] { return tail + n - ch->head.load(std::memory_order_acquire) <= capacity; })) {
+                        return;
+                    }
+                    Slot* slots = ch->slots();
+                    for (std::size_t i = 0; i < n; ++i) {
+                        slots[(tail + i) & (capacity - 1)] = Slot{c, scratch[i].value};
+                    }
+                    ch->tail.store(tail + n, std::memory_order_release);
+                    break;
+                }
+
+                case Step::Kind::DELIVER: {
+                    // Valeurs lues par la source au front précédent (cycle c - 1 sans domaine
+                    // d'horloge) : pending -> ready au cycle c
+                    if (c == 0) break;
+                    Channel* ch = channelAt(step.channel);
+                    const std::size_t capacity = channels[step.channel].capacity;
+                    if (!waitFor(control, [&] { return ch->done.load(std::memory_order_acquire) >= c; })) return;
+                    std::uint64_t head = ch->head.load(std::memory_order_relaxed);
+                    std::uint64_t tail = ch->tail.load(std::memory_order_acquire);
+                    const Slot* slots = ch->slots();
+                    std::size_t n = 0;
+                    while (head + n < tail && slots[(head + n) & (capacity - 1)].cycle < c) {
+                        scratch[n] = DataValue(slots[(head + n) & (capacity - 1)].value, true);
+                        ++n;
+                    }
+                    ch->head.store(head + n, std::memory_order_release);
+                    step.bus->deliver(scratch.data(), n);
+                    break;
+                }
+            }
+        }
+        for (std::uint32_t ch : outbound[k]) channelAt(ch)->done.store(c + 1, std::memory_order_release);
+    }
+}
+
+// ========================= Run =========================
+bool PartitionedRun::run(std::uint64_t cycles, std::ostream& os) {
+    if (!segment) {
+        segment = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (segment == MAP_FAILED) {
+            segment = nullptr;
+            Log::error() << "Error: Could not map shared memory for " << partitions << " partitions";
+            return false;
+        }
+    }
+    char* base = static_cast<char*>(segment);
+    Control* control = new (base) Control{};
+    for (const ChannelInfo& ch : channels) new (base + ch.offset) Channel{};
+
+    // Sortie de chaque partition dans un fichier temporaire, recopiée dans l'ordre à la fin
+    std::vector<std::FILE*> outputs(partitions, nullptr);
+    for (auto& f : outputs) {
+        f = std::tmpfile();
+        if (!f) {
+            Log::error() << "Error: Could not create partition output file";
+            for (auto* g : outputs) if (g) std::fclose(g);
+            return false;
+        }
+    }
+
+    os.flush();
+    std::vector<pid_t> pids(partitions, -1);
+    bool ok = true;
+    for (unsigned k = 0; k < partitions; ++k) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            Log::error() << "Error: fork failed for partition " << k;
+            control->failed.store(1);
+            ok = false;
+            break;
+        }
+        if (pid == 0) {
+            FileBuffer buffer(outputs[k]);
+            std::cout.rdbuf(&buffer);
+            runPartition(k, cycles);
+            if (!control->failed.load()) {
+                std::cout << "Partition " << k << " final state:" << std::endl;
+                for (const Step& step : steps[k]) {
+                    if (step.kind != Step::Kind::FETCH) step.component->printInfo();
+                }
+            }
+            std::cout.flush();
+            _exit(control->failed.load() ? 1 : 0);
+        }
+        pids[k] = pid;
+    }
+
+    // Une partition en échec arrête les autres (elles pourraient l'attendre indéfiniment)
+    std::size_t running = 0;
+    for (pid_t pid : pids) if (pid > 0) ++running;
+    while (running > 0) {
+        int status = 0;
+        pid_t pid = wait(&status);
+        if (pid < 0) break;
+        --running;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            if (ok) {
+                unsigned k = static_cast<unsigned>(std::find(pids.begin(), pids.end(), pid) - pids.begin());
+                Log::error() << "Error: partition " << k << " failed";
+            }
+            ok = false;
+            control->failed.store(1);
+        }
+    }
+
+    for (unsigned k = 0; k < partitions; ++k) {
+        os << "=== Partition " << k << " ===" << std::endl;
+        std::rewind(outputs[k]);
+        char buffer[1 << 14];
+        std::size_t n;
+        while ((n = std::fread(buffer, 1, sizeof(buffer), outputs[k])) > 0) os.write(buffer, static_cast<std::streamsize>(n));
+        std::fclose(outputs[k]);
+    }
+    os.flush();
+    return ok;
+}
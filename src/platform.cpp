@@ -1,4 +1,10 @@
 #include "platform.h"
+#include "dispatch.h"
+#include "config.h"
+#include "scheduler.h"
+#include "dma.h"
+#include <algorithm>
+#include <optional>
 
 // ========================= Constructor / Destructor =========================
 Platform::Platform(const std::string& lbl)
@@ -13,87 +19,172 @@ ReadableComponentRegistry& Platform::getRegistry() {
 }
 
 // ========================= Load from File =========================
+// Seule la racine est testée ici : le type des COMPONENT (image comprise) vient du
+// cache (ConfigCache::componentType), sans rouvrir les fichiers
 bool Platform::loadFromFile(const std::string& filename) {
-    std::cout << "Loading platform configuration from " << filename << std::endl;
+    if (isImageFile(filename)) {
+        return loadImage(filename);
+    }
+    return loadConfig(filename);
+}
+
+bool Platform::loadConfig(const std::string& filename) {
+    Log::info() << "Loading platform configuration from " << filename;
 
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open " << filename << std::endl;
+    // La racine enregistre toute sa hiérarchie dans sa propre registry
+    std::optional<ReadableComponentRegistry::Scope> scope;
+    if (arena == &ownArena) scope.emplace(registry);
+
+    // Premier passage sur cet arbre : tous les fichiers sont lus et parsés en parallèle,
+    // les loadFromFile ci-dessous ne font ensuite que des accès au cache
+    if (!ConfigCache::isCached(filename)) {
+        ConfigCache::prefetch(filename);
+    }
+
+    auto cfg = ConfigCache::getConfig(filename);
+    if (!cfg) {
+        Log::error() << "Error: Could not open " << filename;
         return false;
     }
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) {
-            continue;
-        }
-        std::istringstream iss(line);
-        std::string key, value;
-        if (std::getline(iss, key, ':') && std::getline(iss, value)) {
-            key = trim(key);
-            value = trim(value);
-
-            if (key == "TYPE") {
-                if (value != "PLATFORM") {
-                    std::cerr << "Error: TYPE must be 'PLATFORM', found '" << value << "' instead." << std::endl;
-                    return false;
+    std::string outputLabel;
+    for (const auto& [key, value] : cfg->entries) {
+        if (key == "TYPE") {
+            if (value != "PLATFORM") {
+                Log::error() << "Error: TYPE must be 'PLATFORM', found '" << value << "' instead.";
+                return false;
+            }
+        } else if (key == "LABEL") {
+            setLabel(value);
+        } else if (key == "CLOCK") {
+            parseClock(value);
+        } else if (key == "OUTPUT") {
+            outputLabel = value;
+        } else if (key == "COMPONENT") {
+            std::string type = ConfigCache::componentType(value);
+            if (type == "CPU") {
+                CPU* processor = arena->make<CPU>();
+                if (processor->loadFromFile(value)) {
+                    registry.registerComponent(processor);
+                    cpus.push_back(processor);
+                    componentFiles.emplace_back(value, processor);
+                } else {
+                    Log::error() << "Error loading CPU from " << value;
+                }
+            } else if (type == "MEMORY") {
+                Memory* mem = arena->make<Memory>();
+                if (mem->loadFromFile(value)) {
+                    registry.registerComponent(mem);
+                    memories.push_back(mem);
+                    componentFiles.emplace_back(value, mem);
+                } else {
+                    Log::error() << "Error loading Memory from " << value;
                 }
-            } else if (key == "LABEL") {
-                setLabel(value);
-            } else if (key == "COMPONENT") {
-                std::string pathto, toload;
-
-                std::istringstream isp(value);
-                if (std::getline(isp, pathto, '/') && std::getline(isp, toload)) {
-                    if (toload.find("cpu") != std::string::npos) {
-                        auto processor = std::make_unique<CPU>();
-                        if (processor->loadFromFile(value)) {
-                            registry.registerComponent(processor.get());
-                            cpus.push_back(std::move(processor));
-                        } else {
-                            std::cerr << "Error loading CPU from " << line << std::endl;
-                        }
-                    } else if (toload.find("mem") != std::string::npos) {
-                        auto mem = std::make_unique<Memory>();
-                        if (mem->loadFromFile(value)) {
-                            registry.registerComponent(mem.get());
-                            memories.push_back(std::move(mem));
-                        } else {
-                            std::cerr << "Error loading Memory from " << line << std::endl;
-                        }
-                    } else if (toload.find("bus") != std::string::npos) {
-                        auto bus = std::make_unique<BUS>();
-                        if (bus->loadFromFile(value)) {
-                            registry.registerComponent(bus.get());
-                            buses.push_back(std::move(bus));
-                        } else {
-                            std::cerr << "Error loading BUS from " << line << std::endl;
-                        }
-                    } else if (toload.find("display") != std::string::npos) {
-                        auto display = std::make_unique<Display>();
-                        if (display->loadFromFile(value)) {
-                            displays.push_back(std::move(display));
-                        } else {
-                            std::cerr << "Error loading Display from " << line << std::endl;
-                        }
-                    } else if (toload.find("platform") != std::string::npos) {
-                        auto subplatform = std::make_unique<Platform>();
-                        if (subplatform->loadFromFile(value)) {
-                            platforms.push_back(std::move(subplatform));
-                        } else {
-                            std::cerr << "Error loading Platform from " << line << std::endl;
-                        }
-                    } else {
-                        std::cerr << "Error: Unknown component type in " << toload << std::endl;
-                    }
+            } else if (type == "BUS") {
+                BUS* bus = arena->make<BUS>();
+                if (bus->loadFromFile(value)) {
+                    registry.registerComponent(bus);
+                    buses.push_back(bus);
+                    componentFiles.emplace_back(value, bus);
+                } else {
+                    Log::error() << "Error loading BUS from " << value;
                 }
+            } else if (type == "DMA") {
+                Dma* dma = arena->make<Dma>();
+                if (dma->loadFromFile(value)) {
+                    registry.registerComponent(dma);
+                    coroutines.push_back(dma);
+                    componentFiles.emplace_back(value, dma);
+                } else {
+                    Log::error() << "Error loading DMA from " << value;
+                }
+            } else if (type == "DISPLAY") {
+                Display* display = arena->make<Display>();
+                if (display->loadFromFile(value)) {
+                    displays.push_back(display);
+                    componentFiles.emplace_back(value, display);
+                } else {
+                    Log::error() << "Error loading Display from " << value;
+                }
+            } else if (type == "PLATFORM" || type == "IMAGE") {
+                Platform* subplatform = arena->make<Platform>();
+                subplatform->arena = arena;
+                if (type == "IMAGE" ? subplatform->loadImage(value) : subplatform->loadConfig(value)) {
+                    if (subplatform->getOutput()) registry.registerComponent(subplatform);
+                    platforms.push_back(subplatform);
+                    componentFiles.emplace_back(value, subplatform);
+                } else {
+                    Log::error() << "Error loading Platform from " << value;
+                }
+            } else {
+                Log::error() << "Error: Unknown component type in " << value;
             }
         }
     }
 
+    if (!outputLabel.empty()) {
+        ReadableComponent* port = findChild(outputLabel);
+        if (!port) {
+            Log::error() << "Error: OUTPUT \"" << outputLabel << "\" is not a component of " << filename;
+            return false;
+        }
+        bindOutput(port);
+    }
+
+    updateClocked();
+    if (arena == &ownArena) {
+        resolveSources();
+        compactState();
+    }
     return true;
 }
 
+// ========================= Clock Domains =========================
+void Platform::updateClocked() {
+    clocked = false;
+    auto check = [this](const Component* c) { if (!c->getClock().isBase()) clocked = true; };
+    for (auto& cpu : cpus) check(cpu);
+    for (auto& mem : memories) check(mem);
+    for (auto& bus : buses) check(bus);
+    for (auto& co : coroutines) check(co);
+    for (auto& display : displays) check(display);
+    for (auto& platform : platforms) check(platform);
+}
+
+// Seuls les composants dont l'horloge a un front à ce cycle sont simulés, dans l'ordre habituel
+void Platform::simulateClocked() {
+    auto step = [this](Component* c) {
+        if (edges(*c, 1)) c->simulate();
+    };
+    for (auto& cpu : cpus) step(cpu);
+    for (auto& mem : memories) step(mem);
+    for (auto& bus : buses) step(bus);
+    for (auto& co : coroutines) step(co);
+    for (auto& display : displays) step(display);
+    for (auto& platform : platforms) step(platform);
+}
+
+// ========================= Sources différées =========================
+// Une MEMORY ou un DMA peut nommer une source chargée après lui : la liaison se fait
+// ici, tant que la registry de la racine est la registry courante
+void Platform::resolveSources() {
+    forEachComponent([](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<T, Memory> || std::is_same_v<T, CoroutineComponent>) c.getSource();
+    });
+}
+
+// ========================= Arena =========================
+void Platform::compactState() {
+    forEachComponent([this](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<T, CPU> || std::is_same_v<T, BUS> || std::is_same_v<T, Memory> ||
+                      std::is_same_v<T, CoroutineComponent>) {
+            c.placeIn(*arena);
+        }
+    });
+}
+
 // ========================= Print Info =========================
 void Platform::printInfo() const {
     std::cout << "PLATFORM info: "
@@ -101,22 +192,188 @@ void Platform::printInfo() const {
               << " CPUs=" << cpus.size()
               << " Memories=" << memories.size()
               << " Buses=" << buses.size()
+              << " Coroutines=" << coroutines.size()
               << " Displays=" << displays.size()
               << " Subplatforms=" << platforms.size()
               << std::endl;
 }
 
-// ========================= Read =========================
+// ========================= Paramètres =========================
+bool Platform::setComponentParam(const std::string& label, const std::string& key, const std::string& value) {
+    ReadableComponent* c = registry.find(label);
+    if (!c) {
+        Log::error() << "Error: no component labeled '" << label << "'";
+        return false;
+    }
+    return applyParam(*c, label, key, value);
+}
+
+bool Platform::applyParam(Component& c, const std::string& name, const std::string& key, const std::string& value) {
+    if (key == "CLOCK" && scheduler) {
+        Log::error() << "Error: CLOCK of '" << name << "' cannot change during an idle-skipping run";
+        return false;
+    }
+    if (!c.setParam(key, value)) {
+        Log::error() << "Error: invalid parameter " << key << "=" << value << " for '" << name << "'";
+        return false;
+    }
+    if (key == "CLOCK") {
+        updateClocked();
+        forEachComponent([](auto& p) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(p)>, Platform>) p.updateClocked();
+        });
+    } else if (scheduler) {
+        scheduler->reschedule(&c); // son prochain réveil a pu changer (REFRESH, ACCESS...)
+    }
+    return true;
+}
+
+// ========================= Display Output =========================
+void Platform::setDisplayOutput(const Display::Output& out) {
+    forEachComponent([&out](auto& c) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(c)>, Display>) c.setOutput(out);
+    });
+}
+
+// ========================= Component Count =========================
+std::size_t Platform::componentCount() {
+    std::size_t n = 0;
+    forEachComponent([&n](auto&) { ++n; });
+    return n;
+}
+
+// ========================= Output Port =========================
+ReadableComponent* Platform::findChild(const std::string& lbl) const {
+    for (CPU* cpu : cpus) if (cpu->getLabel() == lbl) return cpu;
+    for (Memory* mem : memories) if (mem->getLabel() == lbl) return mem;
+    for (BUS* bus : buses) if (bus->getLabel() == lbl) return bus;
+    for (CoroutineComponent* co : coroutines) if (co->getLabel() == lbl) return co;
+    for (Platform* platform : platforms) if (platform->getLabel() == lbl) return platform;
+    return nullptr;
+}
+
 DataValue Platform::read() {
-    // Implémentation dummy pour respecter l'interface
-    return DataValue{0.0, false};
+    return output ? output.read() : DataValue(0.0, false);
+}
+
+bool Platform::hasData() const {
+    return output && output.hasData();
+}
+
+std::size_t Platform::readBatch(value_t* out, std::size_t max) {
+    return output ? output.readBatch(out, max) : 0;
 }
 
 // ========================= Simulate =========================
 void Platform::simulate() {
-    for (auto& cpu : cpus) cpu->simulate();
-    for (auto& mem : memories) mem->simulate();
-    for (auto& bus : buses) bus->simulate();
-    for (auto& display : displays) display->simulate();
-    for (auto& platform : platforms) platform->simulate();
+    if (profiler) {
+        simulateProfiled();
+    } else if (clocked) {
+        simulateClocked();
+    } else {
+        for (auto& cpu : cpus) cpu->simulate();
+        for (auto& mem : memories) mem->simulate();
+        for (auto& bus : buses) bus->simulate();
+        for (auto& co : coroutines) co->simulate();
+        for (auto& display : displays) display->simulate();
+        for (auto& platform : platforms) platform->simulate();
+    }
+    ++tick;
+}
+
+// Chaque composant avance de n cycles d'un coup, dans l'ordre habituel
+void Platform::simulate(std::uint64_t cycles) {
+    if (profiler) {
+        for (std::uint64_t i = 0; i < cycles; ++i) simulate();
+        return;
+    }
+    if (clocked) {
+        // Chaque domaine avance de ses fronts pendant le quantum
+        auto step = [this, cycles](Component* c) {
+            if (std::uint64_t r = edges(*c, cycles)) c->simulate(r);
+        };
+        for (auto& cpu : cpus) step(cpu);
+        for (auto& mem : memories) step(mem);
+        for (auto& bus : buses) step(bus);
+        for (auto& co : coroutines) step(co);
+        for (auto& display : displays) step(display);
+        for (auto& platform : platforms) step(platform);
+    } else {
+        for (auto& cpu : cpus) cpu->simulate(cycles);
+        for (auto& mem : memories) mem->simulate(cycles);
+        for (auto& bus : buses) bus->simulate(cycles);
+        for (auto& co : coroutines) co->simulate(cycles);
+        for (auto& display : displays) display->simulate(cycles);
+        for (auto& platform : platforms) platform->simulate(cycles);
+    }
+    tick += cycles;
+}
+
+// ========================= Fast-forward =========================
+void Platform::fastForward(std::uint64_t cycles) {
+    auto step = [this, cycles](Component* c) {
+        if (std::uint64_t r = clocked ? edges(*c, cycles) : cycles) c->fastForward(r);
+    };
+    for (auto& cpu : cpus) step(cpu);
+    for (auto& mem : memories) step(mem);
+    for (auto& bus : buses) step(bus);
+    for (auto& co : coroutines) step(co);
+    for (auto& display : displays) step(display);
+    for (auto& platform : platforms) step(platform);
+    tick += cycles;
+}
+
+// ========================= Run =========================
+void Platform::run(std::uint64_t cycles) {
+    if (idleSkipping) {
+        if (!scheduler) scheduler = std::make_unique<Scheduler>(*this);
+        scheduler->run(cycles);
+    } else if (quantum <= 1) {
+        for (std::uint64_t i = 0; i < cycles; ++i) simulate();
+    } else {
+        while (cycles > 0) {
+            std::uint64_t step = std::min(cycles, quantum);
+            simulate(step);
+            cycles -= step;
+        }
+    }
+}
+
+void Platform::setIdleSkipping(bool enabled) {
+    idleSkipping = enabled;
+    scheduler.reset(); // reconstruit au prochain run() : le graphe a pu changer
+}
+
+// ========================= Profiling =========================
+void Platform::setProfiler(Profiler* p, const std::string& parentPath) {
+    profiler = p;
+    profileSlots.clear();
+    std::string path = parentPath.empty() ? getLabel() : parentPath + "/" + getLabel();
+
+    if (p) {
+        for (auto& cpu : cpus) profileSlots.push_back(p->addEntry(path, "CPU", cpu->getLabel()));
+        for (auto& mem : memories) profileSlots.push_back(p->addEntry(path, "MEMORY", mem->getLabel()));
+        for (auto& bus : buses) profileSlots.push_back(p->addEntry(path, "BUS", bus->getLabel()));
+        for (auto& co : coroutines) profileSlots.push_back(p->addEntry(path, co->typeName(), co->getLabel()));
+        for (auto& display : displays) {
+            profileSlots.push_back(p->addEntry(path, "DISPLAY", "<- " + display->getSourceLabel()));
+        }
+    }
+    for (auto& platform : platforms) platform->setProfiler(p, path);
+}
+
+void Platform::simulateProfiled() {
+    std::size_t slot = 0;
+    auto timed = [&](auto& c) {
+        std::size_t s = slot++;
+        if (!clocked || edges(c, 1)) profiler->time(profileSlots[s], c);
+    };
+    for (auto& cpu : cpus) timed(*cpu);
+    for (auto& mem : memories) timed(*mem);
+    for (auto& bus : buses) timed(*bus);
+    for (auto& co : coroutines) timed(*co);
+    for (auto& display : displays) timed(*display);
+    for (auto& platform : platforms) {
+        if (!clocked || edges(*platform, 1)) platform->simulate();
+    }
 }
@@ -0,0 +1,92 @@
+#include "profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+Profiler::Profiler(ClockSource source)
+    : clockSource(source)
+{
+#ifndef PROJC_HAS_TSC
+    clockSource = ClockSource::STEADY;
+#endif
+    startTicks = now();
+    startTime = std::chrono::steady_clock::now();
+}
+
+std::size_t Profiler::addEntry(const std::string& path, const std::string& type, const std::string& label) {
+    entries.push_back(Entry{path, type, label, 0, 0});
+    return entries.size() - 1;
+}
+
+double Profiler::nsPerTick() const {
+    if (clockSource == ClockSource::STEADY) return 1.0;
+    double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+    std::uint64_t elapsedTicks = now() - startTicks;
+    return elapsedTicks ? elapsedNs / static_cast<double>(elapsedTicks) : 1.0;
+}
+
+// ========================= Top N =========================
+void Profiler::writeTop(std::ostream& os, std::size_t n) const {
+    const double scale = nsPerTick();
+    double total = 0.0;
+    for (const auto& e : entries) total += e.ticks * scale;
+    if (total <= 0.0) total = 1.0;
+
+    std::vector<const Entry*> sorted;
+    for (const auto& e : entries) sorted.push_back(&e);
+    std::sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) { return a->ticks > b->ticks; });
+
+    char line[256];
+    os << "=== Profile: top " << std::min(n, sorted.size()) << " components by simulate() time ===\n";
+    std::snprintf(line, sizeof(line), "%4s %12s %7s %12s %10s  %-8s %s\n",
+                  "rank", "total_ms", "%", "calls", "ns/call", "type", "component");
+    os << line;
+    for (std::size_t i = 0; i < sorted.size() && i < n; ++i) {
+        const Entry& e = *sorted[i];
+        double ns = e.ticks * scale;
+        std::snprintf(line, sizeof(line), "%4zu %12.3f %6.2f%% %12llu %10.1f  %-8s ",
+                      i + 1, ns / 1e6, 100.0 * ns / total, static_cast<unsigned long long>(e.calls),
+                      e.calls ? ns / e.calls : 0.0, e.type.c_str());
+        os << line << e.path << "/" << e.label << "\n";
+    }
+
+    // Agrégat par type de composant
+    std::map<std::string, std::pair<double, std::uint64_t>> byType;
+    for (const auto& e : entries) {
+        byType[e.type].first += e.ticks * scale;
+        byType[e.type].second += e.calls;
+    }
+    os << "=== Profile: by component type ===\n";
+    std::snprintf(line, sizeof(line), "%-8s %12s %7s %12s %10s\n", "type", "total_ms", "%", "calls", "ns/call");
+    os << line;
+    for (const auto& [type, t] : byType) {
+        std::snprintf(line, sizeof(line), "%-8s %12.3f %6.2f%% %12llu %10.1f\n",
+                      type.c_str(), t.first / 1e6, 100.0 * t.first / total,
+                      static_cast<unsigned long long>(t.second), t.second ? t.first / t.second : 0.0);
+        os << line;
+    }
+}
+
+// ========================= Folded stacks =========================
+// Une ligne par composant : "Top;Sous-plateforme;TYPE label <ns>"
+void Profiler::writeFolded(std::ostream& os) const {
+    const double scale = nsPerTick();
+    auto frame = [](std::string s) {
+        std::replace(s.begin(), s.end(), ';', '_');
+        return s;
+    };
+
+    for (const auto& e : entries) {
+        if (e.calls == 0) continue;
+        std::string stack;
+        std::size_t start = 0;
+        while (start <= e.path.size()) {
+            std::size_t end = e.path.find('/', start);
+            if (end == std::string::npos) end = e.path.size();
+            stack += frame(e.path.substr(start, end - start)) + ";";
+            start = end + 1;
+        }
+        os << stack << frame(e.type + " " + e.label) << " "
+           << static_cast<std::uint64_t>(e.ticks * scale) << "\n";
+    }
+}
@@ -0,0 +1,135 @@
+#include "reload.h"
+#include "platform.h"
+#include "config.h"
+#include <set>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// Clés qui décrivent la structure de la plateforme : prises en compte au redémarrage seulement
+static bool structural(const std::string& key) {
+    return key == "TYPE" || key == "LABEL" || key == "SOURCE" || key == "PROGRAM" || key == "COMPONENT"
+        || key == "OUTPUT";
+}
+
+static std::string directoryOf(const std::string& path) {
+    std::size_t slash = path.find_last_of('/');
+    if (slash == std::string::npos) return ".";
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+static std::string fileNameOf(const std::string& path) {
+    return path.substr(path.find_last_of('/') + 1);
+}
+
+// Toutes les valeurs de key, dans l'ordre du fichier (COMPONENT peut être répété)
+static std::vector<std::string> valuesOf(const ConfigFile* cfg, const std::string& key) {
+    std::vector<std::string> values;
+    if (!cfg) return values;
+    for (const auto& [k, v] : cfg->entries) {
+        if (k == key) values.push_back(v);
+    }
+    return values;
+}
+
+// ========================= Constructor / Destructor =========================
+HotReload::HotReload(Platform& p)
+    : platform(p)
+{
+    std::vector<Platform*> stack{&p};
+    while (!stack.empty()) {
+        Platform* current = stack.back();
+        stack.pop_back();
+        for (const auto& [path, component] : current->getComponentFiles()) {
+            files.push_back({path, component, ConfigCache::getConfig(path)});
+        }
+        for (Platform* sub : current->getSubplatforms()) stack.push_back(sub);
+    }
+
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        Log::warning() << "Warning: inotify is not available, configs are only reloaded on request";
+        return;
+    }
+    std::set<std::string> dirs;
+    for (const Watched& w : files) dirs.insert(directoryOf(w.path));
+    for (const std::string& dir : dirs) {
+        // Écriture sur place ou remplacement par renommage (éditeurs)
+        int wd = inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd >= 0) {
+            dirOf[wd] = dir;
+        } else {
+            Log::warning() << "Warning: Could not watch " << dir;
+        }
+    }
+}
+
+HotReload::~HotReload() {
+    if (fd >= 0) ::close(fd);
+}
+
+// ========================= Poll =========================
+std::size_t HotReload::poll() {
+    bool all = requested.exchange(false);
+    std::set<std::string> changed; // "répertoire/fichier", comme directoryOf + fileNameOf
+    if (fd >= 0) {
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            ssize_t n = ::read(fd, buffer, sizeof(buffer));
+            if (n <= 0) break; // EAGAIN : plus d'événement en attente
+            for (char* ptr = buffer; ptr < buffer + n;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+                auto it = dirOf.find(event->wd);
+                if (it != dirOf.end() && event->len > 0) changed.insert(it->second + "/" + event->name);
+                ptr += sizeof(inotify_event) + event->len;
+            }
+        }
+    }
+    if (!all && changed.empty()) return 0;
+
+    // Un fichier partagé par plusieurs composants n'est relu qu'une fois
+    std::unordered_map<std::string, std::shared_ptr<const ConfigFile>> fresh;
+    std::size_t applied = 0;
+    for (Watched& w : files) {
+        if (!all && !changed.count(directoryOf(w.path) + "/" + fileNameOf(w.path))) continue;
+        auto it = fresh.find(w.path);
+        if (it == fresh.end()) it = fresh.emplace(w.path, ConfigCache::reloadConfig(w.path)).first;
+        if (!it->second) {
+            Log::warning() << "Warning: Could not reread " << w.path << ", parameters kept";
+            continue;
+        }
+        applied += apply(w, it->second);
+    }
+    return applied;
+}
+
+// ========================= Apply =========================
+std::size_t HotReload::apply(Watched& w, const std::shared_ptr<const ConfigFile>& cfg) {
+    if (cfg == w.applied) return 0; // même contenu (le cache partage les configs identiques)
+
+    // Clés du nouveau fichier, puis celles qui ont disparu
+    std::vector<std::string> keys;
+    std::set<std::string> seen;
+    for (const ConfigFile* c : {cfg.get(), w.applied.get()}) {
+        if (!c) continue;
+        for (const auto& entry : c->entries) {
+            if (seen.insert(entry.first).second) keys.push_back(entry.first);
+        }
+    }
+
+    std::size_t n = 0;
+    for (const std::string& key : keys) {
+        std::vector<std::string> before = valuesOf(w.applied.get(), key);
+        std::vector<std::string> after = valuesOf(cfg.get(), key);
+        if (before == after) continue;
+        if (structural(key)) {
+            Log::warning() << "Warning: " << key << " changed in " << w.path << ", ignored until restart";
+        } else if (after.empty()) {
+            Log::warning() << "Warning: " << key << " removed from " << w.path << ", current value kept";
+        } else if (platform.applyParam(*w.component, w.path, key, after.front())) {
+            Log::info() << "Reloaded " << w.path << ": " << key << "=" << after.front();
+            ++n;
+        }
+    }
+    w.applied = cfg;
+    return n;
+}
@@ -0,0 +1,198 @@
+#include "sampling.h"
+#include "platform.h"
+#include <cmath>
+#include <limits>
+
+
+static const char* const METRIC_NAMES[SampledRun::METRICS] = {
+    "produced", "consumed", "stall_cycles", "dropped", "empty_reads", "avg_occupancy"
+};
+
+// Quantile 0.975 de la loi de Student à df degrés de liberté (loi normale au-delà de 30)
+static double studentT975(std::uint64_t df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df == 0) return std::numeric_limits<double>::quiet_NaN();
+    return df <= 30 ? table[df - 1] : 1.960;
+}
+
+static void writeNumber(std::ostream& os, double x, bool json) {
+    if (std::isnan(x)) os << (json ? "null" : "");
+    else os << x;
+}
+
+// ========================= Constructor =========================
+SampledRun::SampledRun(Platform& p, std::uint64_t per, std::uint64_t win, std::uint64_t warm)
+    : platform(p), period(per), window(win), warmup(warm)
+{
+    platform.forEachComponentPath([this](auto& c, const std::string& path) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(c)>, Platform>) {
+            Entry e;
+            e.path = path;
+            e.type = report::typeName(c);
+            e.label = report::nameOf(c);
+            e.component = &c;
+            entries.push_back(std::move(e));
+        }
+    });
+}
+
+bool SampledRun::parse(const std::string& spec, std::uint64_t& per, std::uint64_t& win, std::uint64_t& warm) {
+    std::vector<std::uint64_t> fields;
+    std::size_t start = 0;
+    for (;;) {
+        std::size_t colon = spec.find(':', start);
+        std::string field = spec.substr(start, colon == std::string::npos ? std::string::npos : colon - start);
+        if (field.empty() || field.find_first_not_of("0123456789") != std::string::npos) return false;
+        try { fields.push_back(std::stoull(field)); }
+        catch (...) { return false; }
+        if (colon == std::string::npos) break;
+        start = colon + 1;
+    }
+    if (fields.size() < 2 || fields.size() > 3) return false;
+    std::uint64_t w = fields[1];
+    std::uint64_t u = fields.size() == 3 ? fields[2] : 0;
+    if (w == 0 || w > fields[0] || u > fields[0] - w) return false;
+    per = fields[0];
+    win = w;
+    warm = u;
+    return true;
+}
+
+// ========================= Run =========================
+void SampledRun::run(std::uint64_t total) {
+    std::uint64_t done = 0;
+    while (done < total) {
+        if (total - done < period) {
+            platform.fastForward(total - done);
+            done = total;
+            break;
+        }
+        if (std::uint64_t ff = period - warmup - window) platform.fastForward(ff);
+        done += period - warmup - window;
+        if (warmup) platform.run(warmup);
+        done += warmup;
+
+        Log::info() << "=== Window " << (windows + 1) << ": cycles " << (done + 1) << "-" << (done + window) << " ===";
+        beginWindow();
+        platform.run(window);
+        endWindow();
+        done += window;
+        detailed += warmup + window;
+    }
+    cycles += total;
+}
+
+void SampledRun::beginWindow() {
+    STATS_ONLY(for (Entry& e : entries) e.start = e.component->getStats();)
+}
+
+void SampledRun::endWindow() {
+    ++windows;
+#ifdef PROJC_STATS
+    const double w = static_cast<double>(window);
+    for (Entry& e : entries) {
+        const ComponentStats& s = e.component->getStats();
+        e.metrics[PRODUCED].add(static_cast<double>(s.produced - e.start.produced) / w);
+        e.metrics[CONSUMED].add(static_cast<double>(s.consumed - e.start.consumed) / w);
+        e.metrics[STALL_CYCLES].add(static_cast<double>(s.stallCycles - e.start.stallCycles) / w);
+        e.metrics[DROPPED].add(static_cast<double>(s.dropped - e.start.dropped) / w);
+        e.metrics[EMPTY_READS].add(static_cast<double>(s.emptyReads - e.start.emptyReads) / w);
+        if (std::uint64_t samples = s.samples - e.start.samples) {
+            e.metrics[AVG_OCCUPANCY].add(static_cast<double>(s.occupancySum - e.start.occupancySum)
+                                         / static_cast<double>(samples));
+        }
+    }
+#endif
+}
+
+// ========================= Estimations =========================
+SampledRun::Estimate SampledRun::estimateOf(const Entry& e, Metric metric) const {
+    const Accumulator& a = e.metrics[metric];
+    Estimate est;
+    est.windows = a.n;
+    est.perCycle = a.mean;
+    est.halfWidth = a.n >= 2
+        ? studentT975(a.n - 1) * std::sqrt(a.m2 / static_cast<double>(a.n - 1)) / std::sqrt(static_cast<double>(a.n))
+        : std::numeric_limits<double>::quiet_NaN();
+    return est;
+}
+
+SampledRun::Estimate SampledRun::estimate(const std::string& label, Metric metric) const {
+    for (const Entry& e : entries) {
+        if (e.label == label) return estimateOf(e, metric);
+    }
+    return Estimate{};
+}
+
+// Les compteurs sont extrapolés à tous les cycles simulés, l'occupation reste une moyenne
+void SampledRun::writeReport(std::ostream& os, const std::string& format) const {
+    const double total = static_cast<double>(cycles);
+    const bool csv = (format == "csv");
+    const bool json = (format == "json");
+
+    if (csv) {
+        os << "path,type,label,metric,windows,per_cycle,ci95,estimate,estimate_ci95\n";
+    } else if (json) {
+        os << "{\n  \"cycles\": " << cycles << ", \"period\": " << period << ", \"window\": " << window
+           << ", \"warmup\": " << warmup << ", \"windows\": " << windows << ", \"detailed_cycles\": " << detailed
+           << ",\n  \"components\": [\n";
+    } else {
+        os << "Sampled simulation: " << cycles << " cycles, " << windows << " windows of " << window
+           << " cycles every " << period << " (warmup " << warmup << "), "
+           << (total > 0 ? 100.0 * static_cast<double>(detailed) / total : 0.0) << "% detailed" << std::endl;
+        if (windows < 2) os << "  (at least 2 windows are needed for confidence intervals)" << std::endl;
+    }
+
+    bool first = true;
+    for (const Entry& e : entries) {
+        if (json) {
+            os << (first ? "" : ",\n") << "    {\"path\": \"" << report::jsonEscape(e.path) << "\""
+               << ", \"type\": \"" << e.type << "\", \"label\": \"" << report::jsonEscape(e.label) << "\"";
+        } else if (!csv) {
+            os << "  " << e.type << " \"" << e.label << "\" (" << e.path << ")" << std::endl;
+        }
+        first = false;
+
+        for (int m = 0; m < METRICS; ++m) {
+            Estimate est = estimateOf(e, static_cast<Metric>(m));
+            if (est.windows == 0) continue;
+            const bool extensive = (m != AVG_OCCUPANCY);
+            const double scale = extensive ? total : 1.0;
+            if (csv) {
+                os << report::csvEscape(e.path) << ',' << e.type << ',' << report::csvEscape(e.label) << ','
+                   << METRIC_NAMES[m] << ',' << est.windows << ',' << est.perCycle << ',';
+                writeNumber(os, est.halfWidth, false);
+                os << ',';
+                if (extensive) os << est.perCycle * scale;
+                os << ',';
+                if (extensive) writeNumber(os, est.halfWidth * scale, false);
+                os << '\n';
+            } else if (json) {
+                os << ", \"" << METRIC_NAMES[m] << "\": {\"" << (extensive ? "per_cycle" : "mean") << "\": "
+                   << est.perCycle << ", \"ci95\": ";
+                writeNumber(os, est.halfWidth, true);
+                if (extensive) {
+                    os << ", \"estimate\": " << est.perCycle * scale << ", \"estimate_ci95\": ";
+                    writeNumber(os, est.halfWidth * scale, true);
+                }
+                os << "}";
+            } else {
+                if (est.perCycle == 0.0 && est.halfWidth == 0.0) continue;
+                os << "    " << METRIC_NAMES[m] << ": " << est.perCycle;
+                if (!std::isnan(est.halfWidth)) os << " +/- " << est.halfWidth;
+                if (extensive) {
+                    os << " per cycle, ~" << est.perCycle * scale;
+                    if (!std::isnan(est.halfWidth)) os << " +/- " << est.halfWidth * scale;
+                    os << " in total";
+                }
+                os << std::endl;
+            }
+        }
+        if (json) os << "}";
+    }
+    if (json) os << (first ? "" : "\n") << "  ]\n}\n";
+}
@@ -0,0 +1,181 @@
+#include "scheduler.h"
+#include "platform.h"
+#include <algorithm>
+#include <unordered_map>
+
+// ========================= Constructor =========================
+Scheduler::Scheduler(Platform& platform)
+    : wheel(WHEEL_SIZE)
+{
+    std::unordered_map<const ReadableComponent*, std::uint32_t> indexOf;
+    std::vector<ReadableComponent*> sourceOf;
+
+    platform.forEachComponentClock([&](auto& c, const ClockChain& chain) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (!std::is_same_v<T, Platform>) {
+            std::uint32_t i = static_cast<std::uint32_t>(components.size());
+            components.push_back(&c);
+            clocks.push_back(chain);
+            based.push_back(chain.isBase());
+            if constexpr (std::is_base_of_v<ReadableComponent, T>) {
+                readable.push_back(&c);
+                indexOf[&c] = i;
+            } else {
+                readable.push_back(nullptr);
+            }
+            // Seuls BUS, MEMORY et les coroutines dépendent de l'état de leur source pour se
+            // réveiller (un DISPLAY se réveille à chaque rafraîchissement, données ou non)
+            if constexpr (std::is_same_v<T, BUS> || std::is_same_v<T, Memory> ||
+                          std::is_same_v<T, CoroutineComponent>) {
+                ReadableComponent* src = c.getSource();
+                sourceOf.push_back(src ? src->producer() : nullptr);
+            } else {
+                sourceOf.push_back(nullptr);
+            }
+        }
+    });
+
+    const std::size_t n = components.size();
+    consumers.resize(n);
+    polled.assign(n, false);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (!sourceOf[i]) continue;
+        auto it = indexOf.find(sourceOf[i]);
+        if (it != indexOf.end()) {
+            consumers[it->second].push_back(i);
+        } else {
+            polled[i] = true; // source hors de la plateforme : aucun réveil possible, on l'interroge à chaque cycle
+        }
+    }
+
+    // Au départ, tout le monde est simulé à son premier front (le premier cycle, sauf
+    // domaine d'horloge déphasé ou lent)
+    wake.assign(n, NEVER);
+    done.assign(n, 0);
+    active.assign((n + 63) / 64, 0);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        std::uint64_t first = cycleOf(i, 0);
+        if (first == 0) {
+            wake[i] = 0;
+            active[i / 64] |= std::uint64_t(1) << (i % 64);
+        } else {
+            schedule(i, first);
+        }
+    }
+}
+
+// ========================= Gestion des réveils =========================
+void Scheduler::schedule(std::uint32_t i, std::uint64_t at) {
+    wake[i] = at;
+    if (at == NEVER) return;
+    if (at - cycle < WHEEL_SIZE) {
+        wheel[at & WHEEL_MASK].push_back(i);
+    } else {
+        far.emplace(at, i);
+    }
+}
+
+void Scheduler::wakeConsumers(std::uint32_t i) {
+    for (std::uint32_t j : consumers[i]) {
+        // Un lecteur placé après la source dans l'ordre de simulation la voit dès ce cycle,
+        // à son premier front à partir de là
+        std::uint64_t target = (j > i) ? cycle : cycle + 1;
+        if (!based[j]) target = cycleOf(j, ticksOf(j, target));
+        if (wake[j] <= target) continue;
+        if (target == cycle) {
+            wake[j] = cycle;
+            active[j / 64] |= std::uint64_t(1) << (j % 64);
+        } else {
+            schedule(j, target);
+        }
+    }
+}
+
+// Premier cycle >= cycle où un réveil est prévu, NEVER si la plateforme est entièrement au repos
+std::uint64_t Scheduler::nextEvent() {
+    while (!far.empty() && wake[far.top().second] != far.top().first) far.pop(); // entrées périmées
+    std::uint64_t farNext = far.empty() ? NEVER : far.top().first;
+
+    for (std::uint64_t k = 0; k < WHEEL_SIZE && cycle + k < farNext; ++k) {
+        std::uint64_t t = cycle + k;
+        auto& bucket = wheel[t & WHEEL_MASK];
+        for (std::uint32_t idx : bucket) {
+            if (wake[idx] == t) return t;
+        }
+        bucket.clear(); // seulement des entrées périmées
+    }
+    return farNext;
+}
+
+// Rattrape les cycles sautés d'un composant jusqu'au cycle de base upTo inclus
+void Scheduler::catchUp(std::uint32_t i, std::uint64_t upTo) {
+    std::uint64_t target = ticksOf(i, upTo + 1);
+    if (target > done[i]) {
+        components[i]->skipCycles(target - done[i]);
+        done[i] = target;
+    }
+}
+
+void Scheduler::reschedule(const Component* c) {
+    auto it = std::find(components.begin(), components.end(), c);
+    if (it == components.end()) return;
+    std::uint32_t i = static_cast<std::uint32_t>(it - components.begin());
+    std::uint64_t next = cycleOf(i, ticksOf(i, cycle));
+    if (wake[i] <= next) return;
+    if (next == cycle) {
+        wake[i] = cycle;
+        active[i / 64] |= std::uint64_t(1) << (i % 64);
+    } else {
+        schedule(i, next);
+    }
+}
+
+// ========================= Run =========================
+void Scheduler::run(std::uint64_t cycles) {
+    if (cycles == 0) return;
+    const std::uint64_t end = cycle + cycles;
+
+    while (cycle < end) {
+        // Réveils prévus pour ce cycle
+        auto& bucket = wheel[cycle & WHEEL_MASK];
+        for (std::uint32_t idx : bucket) {
+            if (wake[idx] == cycle) active[idx / 64] |= std::uint64_t(1) << (idx % 64);
+        }
+        bucket.clear();
+        while (!far.empty() && far.top().first <= cycle) {
+            auto [at, idx] = far.top();
+            far.pop();
+            if (at == cycle && wake[idx] == cycle) active[idx / 64] |= std::uint64_t(1) << (idx % 64);
+        }
+
+        // Composants actifs, dans l'ordre de simulation ; un lecteur réveillé pendant le
+        // parcours (indice plus grand) est vu plus loin dans ce même parcours
+        for (std::size_t w = 0; w < active.size(); ++w) {
+            while (std::uint64_t bits = active[w]) {
+                active[w] = bits & (bits - 1);
+                std::uint32_t i = static_cast<std::uint32_t>(w * 64 + __builtin_ctzll(bits));
+                if (wake[i] != cycle) continue;
+
+                std::uint64_t before = ticksOf(i, cycle);
+                std::uint64_t after = ticksOf(i, cycle + 1);
+                if (before > done[i]) components[i]->skipCycles(before - done[i]);
+                if (after > before) components[i]->simulate();
+                done[i] = std::max(done[i], after);
+
+                // Pas de front à ce cycle (réveil par la source) : attend le prochain
+                std::uint64_t next = after;
+                if (after > before && !polled[i]) next = components[i]->nextWakeup(after - 1);
+                schedule(i, cycleOf(i, next));
+                if (readable[i] && readable[i]->hasData()) wakeConsumers(i);
+            }
+        }
+
+        ++cycle;
+        if (cycle < end) {
+            std::uint64_t next = nextEvent();
+            if (next > cycle) cycle = std::min(next, end); // plateforme au repos : avance rapide
+        }
+    }
+
+    for (std::uint32_t i = 0; i < components.size(); ++i) catchUp(i, end - 1);
+}
@@ -0,0 +1,351 @@
+#include "server.h"
+#include "simulation.h"
+#include "platform.h"
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// ========================= Protocole =========================
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    std::size_t start = 0;
+    std::size_t end = line.size();
+    if (end > 0 && line[end - 1] == '\r') --end;
+    for (;;) {
+        std::size_t tab = line.find('\t', start);
+        if (tab == std::string::npos || tab >= end) {
+            fields.push_back(line.substr(start, end - start));
+            return fields;
+        }
+        fields.push_back(line.substr(start, tab - start));
+        start = tab + 1;
+    }
+}
+
+// Un message du log tient sur une ligne et dans un champ
+static std::string oneField(std::string s) {
+    for (char& c : s) {
+        if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+    }
+    return s;
+}
+
+static bool writeAll(int fd, const std::string& data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+static const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERROR: return "ERROR";
+    }
+    return "";
+}
+
+// ========================= Constructor / Destructor =========================
+SimServer::SimServer(const std::string& socketPath, unsigned workers)
+    : path(socketPath), pool(workers ? workers : std::max(1u, std::thread::hardware_concurrency()))
+{
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        Log::error() << "Error: socket path too long: " << path;
+        return;
+    }
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        Log::error() << "Error: Could not create socket " << path;
+        return;
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    ::unlink(path.c_str());
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(listenFd, 64) != 0) {
+        Log::error() << "Error: Could not listen on " << path;
+        ::close(listenFd);
+        listenFd = -1;
+    }
+}
+
+SimServer::~SimServer() {
+    stop();
+    pool.wait();
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(path.c_str());
+    }
+}
+
+// ========================= Cache des plateformes =========================
+std::shared_ptr<const SimServer::CachedPlatform> SimServer::load(const std::string& filename) {
+    auto cached = std::make_shared<CachedPlatform>();
+    cached->filename = filename;
+
+    Log::Sink collect = [&cached](LogLevel level, const std::string& message) {
+        if (level == LogLevel::ERROR && cached->error.empty()) cached->error = message;
+    };
+    Log::Scope scope(&collect);
+    Platform platform("NotLoadedPlatform");
+    if (!platform.loadFromFile(filename)) {
+        if (cached->error.empty()) cached->error = "Error: Failed to load " + filename;
+    } else if (!platform.encodeImage(cached->image)) {
+        cached->error = "Error: Could not encode " + filename;
+    } else {
+        cached->error.clear(); // messages non bloquants (source introuvable...)
+    }
+    return cached;
+}
+
+bool SimServer::addPlatform(const std::string& id, const std::string& filename) {
+    std::lock_guard<std::mutex> loading(loadMtx);
+    auto cached = load(filename);
+    if (!cached->error.empty()) {
+        Log::error() << cached->error;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(cacheMtx);
+    if (cache.find(id) == cache.end()) order.push_back(id);
+    cache[id] = cached;
+    return true;
+}
+
+// Identifiant inconnu : chemin d'une config, mise en cache si elle se charge
+std::shared_ptr<const SimServer::CachedPlatform> SimServer::platformFor(const std::string& id) {
+    {
+        std::lock_guard<std::mutex> lock(cacheMtx);
+        auto it = cache.find(id);
+        if (it != cache.end()) return it->second;
+    }
+    std::lock_guard<std::mutex> loading(loadMtx);
+    {
+        std::lock_guard<std::mutex> lock(cacheMtx);
+        auto it = cache.find(id);
+        if (it != cache.end()) return it->second;
+    }
+    auto cached = load(id);
+    if (cached->error.empty()) {
+        std::lock_guard<std::mutex> lock(cacheMtx);
+        cache[id] = cached;
+        order.push_back(id);
+    }
+    return cached;
+}
+
+// ========================= Boucle principale =========================
+void SimServer::serve() {
+    if (listenFd < 0) return;
+    while (!stopping.load()) {
+        pollfd pfd{listenFd, POLLIN, 0};
+        if (::poll(&pfd, 1, 200) <= 0) continue;
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) continue;
+        {
+            std::lock_guard<std::mutex> lock(connectionsMtx);
+            ++connections;
+        }
+        std::thread([this, fd] {
+            handle(fd);
+            ::close(fd);
+            std::lock_guard<std::mutex> lock(connectionsMtx);
+            if (--connections == 0) connectionsDone.notify_all();
+        }).detach();
+    }
+    // readLine() et les jobs voient stopping : les connexions se terminent d'elles-mêmes
+    std::unique_lock<std::mutex> lock(connectionsMtx);
+    connectionsDone.wait(lock, [this] { return connections == 0; });
+    lock.unlock();
+    pool.wait();
+}
+
+// Lecture d'une ligne, en vérifiant régulièrement l'arrêt du serveur
+bool SimServer::readLine(int fd, std::string& buffer, std::string& line) {
+    for (;;) {
+        std::size_t nl = buffer.find('\n');
+        if (nl != std::string::npos) {
+            line = buffer.substr(0, nl);
+            buffer.erase(0, nl + 1);
+            return true;
+        }
+        if (stopping.load()) return false;
+        pollfd pfd{fd, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, 200);
+        if (ready < 0) return false;
+        if (ready == 0) continue;
+        char chunk[4096];
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buffer.append(chunk, static_cast<std::size_t>(n));
+    }
+}
+
+void SimServer::handle(int fd) {
+    std::string buffer, line;
+    while (readLine(fd, buffer, line)) {
+        std::vector<std::string> fields = splitFields(line);
+        const std::string& request = fields[0];
+        bool ok = true;
+        if (request == "RUN") {
+            // Sur un worker ; la connexion attend sa fin avant la requête suivante
+            std::promise<void> finished;
+            pool.submit([this, fd, &fields, &finished] {
+                runJob(fd, fields);
+                finished.set_value();
+            });
+            finished.get_future().wait();
+        } else if (request == "PING") {
+            ok = writeAll(fd, "PONG\n");
+        } else if (request == "LIST") {
+            std::string out;
+            {
+                std::lock_guard<std::mutex> lock(cacheMtx);
+                for (const std::string& id : order) out += "PLATFORM\t" + id + "\t" + cache[id]->filename + "\n";
+            }
+            ok = writeAll(fd, out + "DONE\n");
+        } else if (request == "SHUTDOWN") {
+            writeAll(fd, "DONE\n");
+            stop();
+            return;
+        } else if (!request.empty()) {
+            ok = writeAll(fd, "ERROR\tunknown request '" + oneField(request) + "'\n");
+        }
+        if (!ok) return;
+    }
+}
+
+// ========================= Job =========================
+void SimServer::runJob(int fd, const std::vector<std::string>& fields) {
+    if (fields.size() < 3 || (fields.size() - 3) % 3 != 0) {
+        writeAll(fd, "ERROR\tusage: RUN <platform> <cycles> [<label> <KEY> <value>]...\n");
+        return;
+    }
+    std::uint64_t cycles = 0;
+    try {
+        if (fields[2].find_first_not_of("0123456789") != std::string::npos) throw std::invalid_argument(fields[2]);
+        cycles = std::stoull(fields[2]);
+    } catch (...) {
+        writeAll(fd, "ERROR\tinvalid cycle count '" + oneField(fields[2]) + "'\n");
+        return;
+    }
+
+    auto cached = platformFor(fields[1]);
+    if (!cached->error.empty()) {
+        writeAll(fd, "ERROR\t" + oneField(cached->error) + "\n");
+        return;
+    }
+
+    // Sorties accumulées puis envoyées par blocs ; un client parti interrompt l'envoi
+    std::string out;
+    bool connected = true;
+    auto flush = [&] {
+        if (connected && !out.empty()) connected = writeAll(fd, out);
+        out.clear();
+    };
+
+    Simulation sim;
+    sim.onOutput([&](const Display& display, const value_t* v, std::size_t n) {
+        out += "OUTPUT\t" + oneField(display.getSourceLabel()) + "\t";
+        for (std::size_t i = 0; i < n; ++i) appendValue(out, v[i], display.getFormat(), display.getPrecision());
+        if (n > 0) out.pop_back(); // espace finale
+        out += "\n";
+        if (out.size() >= 65536) flush();
+    });
+    sim.onLog([&](LogLevel level, const std::string& message) {
+        out += std::string("LOG\t") + levelName(level) + "\t" + oneField(message) + "\n";
+    });
+
+    if (!sim.loadImage(cached->image, cached->filename)) {
+        flush();
+        if (connected) writeAll(fd, "ERROR\tcould not clone " + oneField(fields[1]) + "\n");
+        return;
+    }
+    for (std::size_t i = 3; i < fields.size(); i += 3) {
+        if (!sim.setParam(fields[i], fields[i + 1], fields[i + 2])) {
+            flush();
+            if (connected) {
+                writeAll(fd, "ERROR\tinvalid override " + oneField(fields[i]) + " " + oneField(fields[i + 1])
+                             + "=" + oneField(fields[i + 2]) + "\n");
+            }
+            return;
+        }
+    }
+
+    // Par tranches : SHUTDOWN ou un client parti arrête le job entre deux tranches
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t done = 0;
+    while (done < cycles && connected && !stopping.load()) {
+        std::uint64_t chunk = std::min(cycles - done, JOB_CHUNK);
+        sim.step(chunk);
+        done += chunk;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    if (done < cycles) {
+        flush();
+        if (connected) writeAll(fd, "ERROR\tserver shutting down, stopped after " + std::to_string(done) + " cycles\n");
+        return;
+    }
+
+#ifdef PROJC_STATS
+    for (const std::string& label : sim.getLabels()) {
+        ComponentStats s;
+        if (!sim.getStats(label, s)) continue;
+        out += "STATS\t" + oneField(label) + "\t" + std::to_string(s.produced) + "\t" + std::to_string(s.consumed)
+             + "\t" + std::to_string(s.emptyReads) + "\t" + std::to_string(s.dropped)
+             + "\t" + std::to_string(s.stallCycles) + "\n";
+    }
+#endif
+    out += "DONE\t" + std::to_string(cycles) + "\t" + std::to_string(elapsed.count()) + "\n";
+    flush();
+}
+
+// ========================= Client =========================
+SimClient::~SimClient() {
+    if (fd >= 0) ::close(fd);
+}
+
+bool SimClient::connect(const std::string& socketPath) {
+    sockaddr_un addr{};
+    if (socketPath.size() >= sizeof(addr.sun_path)) return false;
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+bool SimClient::send(const std::vector<std::string>& fields) {
+    if (fd < 0) return false;
+    std::string line;
+    for (std::size_t i = 0; i < fields.size(); ++i) line += (i ? "\t" : "") + fields[i];
+    return writeAll(fd, line + "\n");
+}
+
+bool SimClient::readLine(std::string& line) {
+    if (fd < 0) return false;
+    for (;;) {
+        std::size_t nl = buffer.find('\n');
+        if (nl != std::string::npos) {
+            line = buffer.substr(0, nl);
+            buffer.erase(0, nl + 1);
+            return true;
+        }
+        char chunk[4096];
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buffer.append(chunk, static_cast<std::size_t>(n));
+    }
+}
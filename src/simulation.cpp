@@ -0,0 +1,91 @@
+#include "simulation.h"
+#include "platform.h"
+
+// ========================= Constructor / Destructor =========================
+Simulation::Simulation() = default;
+
+Simulation::~Simulation() {
+    Log::Scope scope(&log);
+    platform.reset();
+}
+
+// ========================= Load =========================
+bool Simulation::load(const std::string& filename) {
+    Log::Scope scope(&log);
+    platform.reset();
+    cycle = 0;
+
+    auto loaded = std::make_unique<Platform>("NotLoadedPlatform");
+    if (!loaded->loadFromFile(filename)) return false;
+    adopt(std::move(loaded));
+    return true;
+}
+
+bool Simulation::loadImage(const std::string& image, const std::string& name) {
+    Log::Scope scope(&log);
+    platform.reset();
+    cycle = 0;
+
+    auto loaded = std::make_unique<Platform>("NotLoadedPlatform");
+    if (!loaded->decodeImage(image.data(), image.size(), name)) return false;
+    adopt(std::move(loaded));
+    return true;
+}
+
+void Simulation::adopt(std::unique_ptr<Platform> loaded) {
+    loaded->setDisplayOutput([this](const Display& display, const value_t* values, std::size_t n) {
+        if (output) output(display, values, n);
+    });
+    platform = std::move(loaded);
+}
+
+bool Simulation::setParam(const std::string& label, const std::string& key, const std::string& value) {
+    if (!platform) return false;
+    Log::Scope scope(&log);
+    return platform->setComponentParam(label, key, value);
+}
+
+// ========================= Step =========================
+void Simulation::step(std::uint64_t cycles) {
+    if (!platform) return;
+    Log::Scope scope(&log);
+    platform->run(cycles);
+    cycle += cycles;
+}
+
+// ========================= Components =========================
+ReadableComponent* Simulation::find(const std::string& label) const {
+    return platform ? platform->getRegistry().find(label) : nullptr;
+}
+
+DataValue Simulation::read(const std::string& label) {
+    ReadableComponent* c = find(label);
+    if (!c) return DataValue(0.0, false);
+    Log::Scope scope(&log);
+    return c->read();
+}
+
+bool Simulation::hasData(const std::string& label) const {
+    ReadableComponent* c = find(label);
+    return c && c->hasData();
+}
+
+std::vector<std::string> Simulation::getLabels() const {
+    std::vector<std::string> labels;
+    if (!platform) return labels;
+    for (const ReadableComponent* c : platform->getRegistry().components()) labels.push_back(c->getLabel());
+    return labels;
+}
+
+bool Simulation::getStats(const std::string& label, ComponentStats& out) const {
+#ifdef PROJC_STATS
+    ReadableComponent* c = find(label);
+    if (!c) return false;
+    out = c->getStats();
+    return true;
+#else
+    (void)label;
+    (void)out;
+    return false;
+#endif
+}
@@ -0,0 +1,90 @@
+#include "platform.h"
+
+// ========================= Noms pour le rapport =========================
+namespace report {
+
+const char* typeName(const CPU&) { return "CPU"; }
+const char* typeName(const Memory&) { return "MEMORY"; }
+const char* typeName(const BUS&) { return "BUS"; }
+const char* typeName(const Display&) { return "DISPLAY"; }
+const char* typeName(const CoroutineComponent& c) { return c.typeName(); }
+
+std::string nameOf(const ReadableComponent& c) { return c.getLabel(); }
+std::string nameOf(const Display& d) { return "DISPLAY <- " + d.getSourceLabel(); }
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+std::string csvEscape(const std::string& s) {
+    if (s.find_first_of(",\"") == std::string::npos) return s;
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+} // namespace report
+
+#ifdef PROJC_STATS
+
+// ========================= Write Stats =========================
+bool Platform::writeStats(std::ostream& os, const std::string& format) {
+    const bool csv = (format == "csv");
+    bool first = true;
+
+    if (csv) {
+        os << "path,type,label,produced,consumed,empty_reads,dropped,stall_cycles,"
+              "div_by_zero,peak_occupancy,avg_occupancy\n";
+    } else {
+        os << "{\n  \"components\": [\n";
+    }
+
+    forEachComponentPath([&](auto& c, const std::string& path) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(c)>, Platform>) {
+            return; // les plateformes ne font que contenir des composants
+        } else {
+            const ComponentStats& s = c.getStats();
+            if (csv) {
+                os << report::csvEscape(path) << ',' << report::typeName(c) << ','
+                   << report::csvEscape(report::nameOf(c)) << ','
+                   << s.produced << ',' << s.consumed << ',' << s.emptyReads << ','
+                   << s.dropped << ',' << s.stallCycles << ',' << s.divByZero << ','
+                   << s.peakOccupancy << ',' << s.averageOccupancy() << '\n';
+            } else {
+                os << (first ? "" : ",\n")
+                   << "    {\"path\": \"" << report::jsonEscape(path) << "\""
+                   << ", \"type\": \"" << report::typeName(c) << "\""
+                   << ", \"label\": \"" << report::jsonEscape(report::nameOf(c)) << "\""
+                   << ", \"produced\": " << s.produced
+                   << ", \"consumed\": " << s.consumed
+                   << ", \"empty_reads\": " << s.emptyReads
+                   << ", \"dropped\": " << s.dropped
+                   << ", \"stall_cycles\": " << s.stallCycles
+                   << ", \"div_by_zero\": " << s.divByZero
+                   << ", \"peak_occupancy\": " << s.peakOccupancy
+                   << ", \"avg_occupancy\": " << s.averageOccupancy()
+                   << "}";
+            }
+            first = false;
+        }
+    });
+
+    if (!csv) os << (first ? "" : "\n") << "  ]\n}\n";
+    return true;
+}
+
+#else
+
+bool Platform::writeStats(std::ostream&, const std::string&) {
+    return false;
+}
+
+#endif
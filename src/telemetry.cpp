@@ -0,0 +1,180 @@
+#include "telemetry.h"
+#include "platform.h"
+#include <algorithm>
+#include <limits>
+
+template <typename T>
+static void writeRaw(std::ofstream& f, const T* data, std::size_t n) {
+    f.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(n * sizeof(T)));
+}
+
+static std::uint32_t saturate(std::size_t v) {
+    return v > std::numeric_limits<std::uint32_t>::max() ? std::numeric_limits<std::uint32_t>::max()
+                                                        : static_cast<std::uint32_t>(v);
+}
+
+// ========================= Constructor / Destructor =========================
+Telemetry::Telemetry(Platform& platform, const std::string& filename,
+                     std::uint32_t every, std::uint32_t ds, std::size_t rows)
+    : sampleEvery(every ? every : 1), downsample(ds ? ds : 1)
+{
+    // Un bloc contient toujours un nombre entier de groupes de réduction
+    rowsPerBlock = std::max<std::size_t>(rows, downsample);
+    rowsPerBlock -= rowsPerBlock % downsample;
+
+    platform.forEachComponent([this](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<T, BUS>) {
+            columns.push_back({ColumnKind::BUS_READY, &c});
+            names.push_back(c.getLabel() + ".ready");
+            columns.push_back({ColumnKind::BUS_PENDING, &c});
+            names.push_back(c.getLabel() + ".pending");
+        } else if constexpr (std::is_same_v<T, Memory>) {
+            columns.push_back({ColumnKind::MEMORY_COUNT, &c});
+            names.push_back(c.getLabel() + ".count");
+        } else if constexpr (std::is_same_v<T, CPU>) {
+            columns.push_back({ColumnKind::CPU_REGISTER, &c});
+            names.push_back(c.getLabel() + ".register");
+        }
+    });
+
+    for (auto& b : blocks) {
+        b.cycles.resize(rowsPerBlock);
+        b.values.resize(rowsPerBlock * columns.size());
+    }
+    std::size_t outRows = rowsPerBlock / downsample;
+    outCycles.resize(outRows);
+    outMin.resize(outRows);
+    outMax.resize(outRows);
+    outAvg.resize(outRows);
+
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        Log::error() << "Error: Could not open " << filename;
+        return;
+    }
+
+    std::uint32_t n = static_cast<std::uint32_t>(columns.size());
+    file.write(MAGIC, sizeof(MAGIC));
+    writeRaw(file, &n, 1);
+    writeRaw(file, &sampleEvery, 1);
+    writeRaw(file, &downsample, 1);
+    for (const auto& name : names) {
+        std::uint32_t size = static_cast<std::uint32_t>(name.size());
+        writeRaw(file, &size, 1);
+        file.write(name.data(), size);
+    }
+
+    flusher = std::thread([this] { flushLoop(); });
+}
+
+Telemetry::~Telemetry() {
+    close();
+}
+
+// ========================= Sample (chemin chaud) =========================
+void Telemetry::sample(std::uint64_t cycle) {
+    if (!file.is_open()) return;
+
+    Block& b = blocks[active];
+    b.cycles[b.rows] = cycle;
+    std::uint32_t* row = b.values.data() + b.rows * columns.size();
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        const Column& col = columns[i];
+        switch (col.kind) {
+            case ColumnKind::BUS_READY:
+                row[i] = saturate(static_cast<const BUS*>(col.component)->getReadySize());
+                break;
+            case ColumnKind::BUS_PENDING:
+                row[i] = saturate(static_cast<const BUS*>(col.component)->getPendingSize());
+                break;
+            case ColumnKind::MEMORY_COUNT:
+                row[i] = saturate(static_cast<const Memory*>(col.component)->getCount());
+                break;
+            case ColumnKind::CPU_REGISTER:
+                row[i] = saturate(static_cast<const CPU*>(col.component)->getRegisterDepth());
+                break;
+        }
+    }
+
+    if (++b.rows == rowsPerBlock) handOff();
+}
+
+// Passe le bloc actif au flusher et bascule sur l'autre (attend qu'il soit libéré)
+void Telemetry::handOff() {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [this] { return toFlush == nullptr; });
+    toFlush = &blocks[active];
+    active = 1 - active;
+    blocks[active].rows = 0;
+    cv.notify_all();
+}
+
+// ========================= Flush (thread de fond) =========================
+void Telemetry::flushLoop() {
+    for (;;) {
+        Block* block;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this] { return toFlush != nullptr || stopping; });
+            if (!toFlush) return;
+            block = toFlush;
+        }
+
+        writeBlock(*block);
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            block->rows = 0;
+            toFlush = nullptr;
+        }
+        cv.notify_all();
+    }
+}
+
+void Telemetry::writeBlock(const Block& block) {
+    if (block.rows == 0) return;
+    const std::size_t n_cols = columns.size();
+    const std::size_t outRows = (block.rows + downsample - 1) / downsample;
+
+    std::uint32_t rows32 = static_cast<std::uint32_t>(outRows);
+    writeRaw(file, &rows32, 1);
+    for (std::size_t r = 0; r < outRows; ++r) outCycles[r] = block.cycles[r * downsample];
+    writeRaw(file, outCycles.data(), outRows);
+
+    for (std::size_t c = 0; c < n_cols; ++c) {
+        for (std::size_t r = 0; r < outRows; ++r) {
+            std::size_t first = r * downsample;
+            std::size_t last = std::min(block.rows, first + downsample);
+            std::uint32_t mn = std::numeric_limits<std::uint32_t>::max(), mx = 0;
+            double sum = 0.0;
+            for (std::size_t k = first; k < last; ++k) {
+                std::uint32_t v = block.values[k * n_cols + c];
+                mn = std::min(mn, v);
+                mx = std::max(mx, v);
+                sum += v;
+            }
+            outMin[r] = mn;
+            outMax[r] = mx;
+            outAvg[r] = static_cast<float>(sum / static_cast<double>(last - first));
+        }
+        writeRaw(file, outMin.data(), outRows);
+        writeRaw(file, outMax.data(), outRows);
+        writeRaw(file, outAvg.data(), outRows);
+    }
+}
+
+// ========================= Close =========================
+void Telemetry::close() {
+    if (!flusher.joinable()) return;
+
+    // Dernier bloc partiel, puis arrêt du flusher
+    if (blocks[active].rows > 0) handOff();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_all();
+    flusher.join();
+    file.close();
+}
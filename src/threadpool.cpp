@@ -0,0 +1,52 @@
+#include "threadpool.h"
+
+ThreadPool::ThreadPool(unsigned n_threads) {
+    if (n_threads == 0) n_threads = 1;
+    for (unsigned i = 0; i < n_threads; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        tasks.push(std::move(task));
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mtx);
+    allDone.wait(lock, [this] { return tasks.empty() && running == 0; });
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop();
+            ++running;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            --running;
+            if (tasks.empty() && running == 0) allDone.notify_all();
+        }
+    }
+}
@@ -0,0 +1,203 @@
+#include "until.h"
+#include "platform.h"
+
+// Compteurs accessibles par stat:<label>.<compteur>
+#ifdef PROJC_STATS
+static const std::pair<const char*, std::uint64_t ComponentStats::*> COUNTERS[] = {
+    {"produced", &ComponentStats::produced},
+    {"consumed", &ComponentStats::consumed},
+    {"emptyReads", &ComponentStats::emptyReads},
+    {"dropped", &ComponentStats::dropped},
+    {"stallCycles", &ComponentStats::stallCycles},
+    {"divByZero", &ComponentStats::divByZero},
+};
+#endif
+
+// ========================= Parsing =========================
+bool StopConditions::add(const std::string& spec) {
+    Condition c{spec, Kind::IDLE, "", "", Op::GE, 0.0};
+    if (spec == "idle") {
+        conditions.push_back(c);
+        return true;
+    }
+
+    std::size_t colon = spec.find(':');
+    std::string prefix = colon == std::string::npos ? "" : spec.substr(0, colon);
+    if (prefix == "mem") c.kind = Kind::MEMORY_COUNT;
+    else if (prefix == "value") c.kind = Kind::BUS_VALUE;
+    else if (prefix == "stat") c.kind = Kind::COUNTER;
+    else {
+        Log::error() << "Error: --until '" << spec << "': expected idle, mem:, value: or stat:";
+        return false;
+    }
+
+    // Opérateur : premier caractère de comparaison après le préfixe
+    std::size_t at = spec.find_first_of("<>=!", colon + 1);
+    if (at == std::string::npos) {
+        Log::error() << "Error: --until '" << spec << "': missing comparison (>=, <=, ==, !=, > or <)";
+        return false;
+    }
+    std::string op = spec.substr(at, spec.size() > at + 1 && spec[at + 1] == '=' ? 2 : 1);
+    if (op == ">=") c.op = Op::GE;
+    else if (op == "<=") c.op = Op::LE;
+    else if (op == "==") c.op = Op::EQ;
+    else if (op == "!=") c.op = Op::NE;
+    else if (op == ">") c.op = Op::GT;
+    else if (op == "<") c.op = Op::LT;
+    else {
+        Log::error() << "Error: --until '" << spec << "': invalid comparison '" << op << "'";
+        return false;
+    }
+
+    try {
+        std::size_t used = 0;
+        std::string number = spec.substr(at + op.size());
+        c.threshold = std::stod(number, &used);
+        if (used != number.size()) throw std::invalid_argument(number);
+    } catch (...) {
+        Log::error() << "Error: --until '" << spec << "': invalid number after '" << op << "'";
+        return false;
+    }
+
+    c.label = spec.substr(colon + 1, at - colon - 1);
+    if (c.kind == Kind::COUNTER) {
+        std::size_t dot = c.label.rfind('.');
+        if (dot == std::string::npos) {
+            Log::error() << "Error: --until '" << spec << "': expected stat:<label>.<counter>";
+            return false;
+        }
+        c.counter = c.label.substr(dot + 1);
+        c.label.resize(dot);
+    }
+    if (c.label.empty()) {
+        Log::error() << "Error: --until '" << spec << "': missing label";
+        return false;
+    }
+    conditions.push_back(c);
+    return true;
+}
+
+// ========================= Compilation =========================
+bool StopConditions::compile(Platform& platform) {
+    checks.clear();
+    cpus.clear();
+    buses.clear();
+    memories.clear();
+    others.clear();
+
+    bool ok = true;
+    bool needIdle = false;
+    for (std::size_t i = 0; i < conditions.size(); ++i) {
+        const Condition& c = conditions[i];
+        const void* target = nullptr;
+        if (c.kind == Kind::IDLE) {
+            needIdle = true;
+        } else if (c.kind == Kind::COUNTER) {
+#ifdef PROJC_STATS
+            std::uint64_t ComponentStats::* counter = nullptr;
+            for (const auto& [name, member] : COUNTERS) {
+                if (c.counter == name) counter = member;
+            }
+            if (!counter) {
+                Log::error() << "Error: --until '" << c.spec << "': unknown counter '" << c.counter << "'";
+                ok = false;
+                continue;
+            }
+            platform.forEachComponent([&](auto& comp) {
+                using T = std::decay_t<decltype(comp)>;
+                if constexpr (std::is_base_of_v<ReadableComponent, T>) {
+                    if (!target && comp.getLabel() == c.label) target = &(comp.getStats().*counter);
+                }
+            });
+#else
+            Log::error() << "Error: --until '" << c.spec << "': performance counters are disabled in this build "
+                         << "(make STATS=1)";
+            ok = false;
+            continue;
+#endif
+        } else {
+            platform.forEachComponent([&](auto& comp) {
+                using T = std::decay_t<decltype(comp)>;
+                if constexpr (std::is_same_v<T, Memory>) {
+                    if (c.kind == Kind::MEMORY_COUNT && comp.getLabel() == c.label) target = &comp;
+                } else if constexpr (std::is_same_v<T, BUS>) {
+                    if (c.kind == Kind::BUS_VALUE && comp.getLabel() == c.label) target = &comp;
+                }
+            });
+        }
+        if (c.kind != Kind::IDLE && !target) {
+            Log::error() << "Error: --until '" << c.spec << "': no " << (c.kind == Kind::MEMORY_COUNT ? "MEMORY"
+                         : c.kind == Kind::BUS_VALUE ? "BUS" : "component") << " labeled \"" << c.label << "\"";
+            ok = false;
+            continue;
+        }
+        checks.push_back({c.kind, c.op, c.threshold, target, i});
+    }
+
+    if (needIdle) {
+        platform.forEachComponent([this](auto& comp) {
+            using T = std::decay_t<decltype(comp)>;
+            if constexpr (std::is_same_v<T, CPU>) cpus.push_back(&comp);
+            else if constexpr (std::is_same_v<T, BUS>) buses.push_back(&comp);
+            else if constexpr (std::is_same_v<T, Memory>) memories.push_back(&comp);
+            else if constexpr (std::is_same_v<T, CoroutineComponent>) others.push_back(&comp);
+        });
+    }
+    return ok;
+}
+
+// ========================= Évaluation (chemin chaud) =========================
+bool StopConditions::compare(double v, Op op, double threshold) {
+    switch (op) {
+        case Op::GE: return v >= threshold;
+        case Op::LE: return v <= threshold;
+        case Op::EQ: return v == threshold;
+        case Op::NE: return v != threshold;
+        case Op::GT: return v > threshold;
+        case Op::LT: return v < threshold;
+    }
+    return false;
+}
+
+bool StopConditions::idle() const {
+    for (const CPU* cpu : cpus) {
+        if (cpu->getRegisterDepth() > 0) return false;
+        if (cpu->getFrequency() > 0 && !cpu->getProgram().empty()) return false;
+    }
+    for (const BUS* bus : buses) {
+        if (bus->getReadySize() > 0 || bus->getPendingSize() > 0) return false;
+    }
+    for (const Memory* mem : memories) {
+        if (mem->getCount() > 0) return false;
+    }
+    for (const ReadableComponent* other : others) {
+        if (other->hasData()) return false;
+    }
+    return true;
+}
+
+const std::string* StopConditions::check() const {
+    for (const Check& c : checks) {
+        bool hit = false;
+        switch (c.kind) {
+            case Kind::IDLE:
+                hit = idle();
+                break;
+            case Kind::MEMORY_COUNT:
+                hit = compare(static_cast<double>(static_cast<const Memory*>(c.target)->getCount()), c.op, c.threshold);
+                break;
+            case Kind::BUS_VALUE: {
+                const Fifo<DataValue>& values = static_cast<const BUS*>(c.target)->getPending();
+                for (std::size_t i = 0; i < values.size() && !hit; ++i) {
+                    hit = compare(Value::toDouble(values[i].value), c.op, c.threshold);
+                }
+                break;
+            }
+            case Kind::COUNTER:
+                hit = compare(static_cast<double>(*static_cast<const std::uint64_t*>(c.target)), c.op, c.threshold);
+                break;
+        }
+        if (hit) return &conditions[c.condition].spec;
+    }
+    return nullptr;
+}
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../include/lib.h"
+#include "../include/cpu.h"
+#include "../include/bus.h"
+#include "../include/mem.h"
+#include "../include/display.h"
+#include "../include/dispatch.h"
+
+// ======================================================================================
+//                           MICROBENCHMARKS
+// Mesure des opérations chaudes de chaque composant, à lancer avant/après chaque
+// modification de performance.
+// Procédure, pour chaque benchmark :
+// - warm-up : quelques répétitions non mesurées (caches, prédicteurs de branchement)
+// - répétitions : chaque répétition exécute un lot d'opérations et mesure ns/op
+// - rapport : moyenne, écart-type, min, médiane, p95 et max des ns/op sur les répétitions
+// Usage : microbench [--reps N] [--warmup N] [--batch N] [--filter texte] [--csv]
+// ======================================================================================
+
+// Source infinie : renvoie burst valeurs valides puis une invalide, et recommence
+class BurstSource : public ReadableComponent {
+public:
+    int burst;
+    int idx = 0;
+    double next = 0.0;
+
+    BurstSource(const std::string& lbl, int b) : ReadableComponent(lbl), burst(b) {}
+
+    DataValue read() override {
+        if (idx == burst) {
+            idx = 0;
+            return DataValue{0.0, false};
+        }
+        ++idx;
+        next += 1.0;
+        return DataValue{next, true};
+    }
+
+    void simulate() override {}
+    bool loadFromFile(const std::string&) override { return true; }
+    void printInfo() const override {}
+};
+
+// streambuf qui jette tout : sortie "nulle" pour Display::simulate
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Empêche le compilateur d'éliminer un calcul dont le résultat n'est pas utilisé
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct BenchOptions {
+    int reps{30};
+    int warmup{5};
+    int batch{100000};
+    std::string filter;
+    bool csv{false};
+};
+
+struct BenchResult {
+    std::string name;
+    double mean, stddev, min, median, p95, max;
+};
+
+// Exécute op() batch fois par répétition et renvoie les statistiques en ns/op
+static BenchResult runBench(const std::string& name, const BenchOptions& opt, const std::function<void(int)>& op) {
+    using clock = std::chrono::steady_clock;
+    for (int w = 0; w < opt.warmup; ++w) op(opt.batch);
+
+    std::vector<double> samples;
+    for (int r = 0; r < opt.reps; ++r) {
+        auto t0 = clock::now();
+        op(opt.batch);
+        auto t1 = clock::now();
+        samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / opt.batch);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    double mean = sum / samples.size();
+    double var = 0.0;
+    for (double s : samples) var += (s - mean) * (s - mean);
+    double stddev = samples.size() > 1 ? std::sqrt(var / (samples.size() - 1)) : 0.0;
+    auto at = [&](double q) { return samples[static_cast<std::size_t>(q * (samples.size() - 1))]; };
+
+    return BenchResult{name, mean, stddev, samples.front(), at(0.5), at(0.95), samples.back()};
+}
+
+static void report(const BenchResult& r, bool csv) {
+    if (csv) {
+        std::printf("%s,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                    r.name.c_str(), r.mean, r.stddev, r.min, r.median, r.p95, r.max);
+    } else {
+        std::printf("%-36s %10.3f %9.3f %10.3f %10.3f %10.3f %10.3f\n",
+                    r.name.c_str(), r.mean, r.stddev, r.min, r.median, r.p95, r.max);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions opt;
+    for (int a = 1; a < argc; ++a) {
+        std::string arg = argv[a];
+        if (arg == "--csv") opt.csv = true;
+        else if (arg == "--reps" && a + 1 < argc) opt.reps = std::stoi(argv[++a]);
+        else if (arg == "--warmup" && a + 1 < argc) opt.warmup = std::stoi(argv[++a]);
+        else if (arg == "--batch" && a + 1 < argc) opt.batch = std::stoi(argv[++a]);
+        else if (arg == "--filter" && a + 1 < argc) opt.filter = argv[++a];
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--reps N] [--warmup N] [--batch N] [--filter texte] [--csv]\n";
+            return 1;
+        }
+    }
+    if (opt.reps < 1) opt.reps = 1;
+    if (opt.batch < 1) opt.batch = 1;
+
+    std::vector<std::pair<std::string, std::function<void(int)>>> benches;
+
+    // ---------------- Instruction::compute ----------------
+    benches.emplace_back("Instruction::compute (ADD/MUL/DIV)", [](int n) {
+        Instruction instrs[3] = {Instruction(ADD, 1.5, 2.5), Instruction(MUL, 3.0, 1.25), Instruction(DIV, 9.0, 3.0)};
+        for (int i = 0; i < n; ++i) {
+            double r = instrs[i % 3].compute();
+            keep(r);
+        }
+    });
+
+    // ---------------- Program::compute ----------------
+    static Program program;
+    {
+        std::vector<Instruction> code;
+        for (int i = 0; i < 64; ++i) code.emplace_back(static_cast<OPCODE>(ADD + i % 4), i + 1.0, 2.0);
+        program.assign(code.data(), code.size());
+    }
+    benches.emplace_back("Program::compute (64 instr)", [](int n) {
+        for (int i = 0; i < n; ++i) {
+            Instruction instr = program.compute();
+            keep(instr);
+        }
+    });
+
+    // ---------------- Register::push/pop ----------------
+    static Register reg;
+    for (int i = 0; i < 16; ++i) reg.push(DataValue(i, true));
+    benches.emplace_back("Register::push+pop (depth 16)", [](int n) {
+        for (int i = 0; i < n; ++i) {
+            reg.push(DataValue(i, true));
+            DataValue dv = reg.pop();
+            keep(dv);
+        }
+    });
+
+    // ---------------- BUS::simulate/read ----------------
+    static BurstSource busSource("bench bus source", 4);
+    static BUS bus("bench bus");
+    bus.setWidth(4);
+    bus.bindSource(&busSource);
+    benches.emplace_back("BUS::simulate+read x4 (width 4)", [](int n) {
+        for (int i = 0; i < n; ++i) {
+            bus.simulate();
+            for (int k = 0; k < 4; ++k) {
+                DataValue dv = bus.read();
+                keep(dv);
+            }
+        }
+    });
+
+    // ---------------- Memory::pushValue/read ----------------
+    static Memory mem("bench memory");
+    mem.setSize(64);
+    benches.emplace_back("Memory::pushValue+read (size 64)", [](int n) {
+        for (int i = 0; i < n; ++i) {
+            mem.pushValue(DataValue(i, true));
+            DataValue dv = mem.read();
+            keep(dv);
+        }
+    });
+
+    // ---------------- Display::simulate ----------------
+    static BurstSource displaySource("bench display source", 8);
+    static Display display(1);
+    display.bindSource(&displaySource);
+    benches.emplace_back("Display::simulate (8 values, null)", [](int n) {
+        NullBuffer null;
+        std::streambuf* saved = std::cout.rdbuf(&null);
+        for (int i = 0; i < n; ++i) display.simulate();
+        std::cout.rdbuf(saved);
+    });
+
+    // ---------------- Saut de données : vtable vs SourceHandle typé ----------------
+    // Même lecture Memory::read(), appelée via ReadableComponent* (virtuel) ou via un
+    // handle lié au type concret (appel qualifié inliné)
+    static Memory hopMem("bench hop memory");
+    hopMem.setSize(64);
+    static SourceHandle hopVirtual = SourceHandle::virtualOnly(&hopMem);
+    static SourceHandle hopTyped = &hopMem;
+    benches.emplace_back("hop Memory->read (virtual)", [](int n) {
+        for (int i = 0; i < n; ++i) {
+            hopMem.pushValue(DataValue(i, true));
+            DataValue dv = hopVirtual.read();
+            keep(dv);
+        }
+    });
+    benches.emplace_back("hop Memory->read (typed)", [](int n) {
+        for (int i = 0; i < n; ++i) {
+            hopMem.pushValue(DataValue(i, true));
+            DataValue dv = hopTyped.read();
+            keep(dv);
+        }
+    });
+
+    // Chaîne BUS -> MEMORY complète : le Memory draine le BUS à chaque cycle
+    static BurstSource chainSource("bench chain source", 4);
+    static BUS chainBusV("bench chain bus virtual"), chainBusT("bench chain bus typed");
+    static Memory chainMemV("bench chain memory virtual"), chainMemT("bench chain memory typed");
+    for (BUS* b : {&chainBusV, &chainBusT}) {
+        b->setWidth(4);
+        b->bindSource(&chainSource);
+    }
+    chainMemV.setSize(64);
+    chainMemT.setSize(64);
+    SourceHandle::setTypedDispatch(false);
+    chainMemV.bindSource(&chainBusV);
+    SourceHandle::setTypedDispatch(true);
+    chainMemT.bindSource(&chainBusT);
+    benches.emplace_back("BUS->Memory cycle x4 (virtual)", [](int n) {
+        for (int i = 0; i < n; ++i) {
+            chainBusV.simulate();
+            chainMemV.simulate();
+            for (int k = 0; k < 4; ++k) keep(chainMemV.read());
+        }
+    });
+    benches.emplace_back("BUS->Memory cycle x4 (typed)", [](int n) {
+        for (int i = 0; i < n; ++i) {
+            chainBusT.simulate();
+            chainMemT.simulate();
+            for (int k = 0; k < 4; ++k) keep(chainMemT.read());
+        }
+    });
+
+    if (opt.csv) {
+        std::printf("benchmark,mean_ns,stddev_ns,min_ns,median_ns,p95_ns,max_ns\n");
+    } else {
+        std::printf("reps=%d warmup=%d batch=%d (ns/op)\n", opt.reps, opt.warmup, opt.batch);
+        std::printf("%-36s %10s %9s %10s %10s %10s %10s\n", "benchmark", "mean", "stddev", "min", "median", "p95", "max");
+    }
+    for (auto& [name, op] : benches) {
+        if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) continue;
+        report(runBench(name, opt, op), opt.csv);
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "arena.h"
+#include "fifo.h"
+#include "mem.h"
+
+// ======================================================================================
+//                           TEST ARENA (Arena, Fifo, Memory::readBatch)
+// Procédure :
+// - Arena : alignement de chaque allocation, nouveau bloc quand le bloc courant est
+//   plein, bloc dédié pour une allocation plus grande qu'un bloc, destructeurs de make()
+//   appelés dans l'ordre inverse de création
+// - Fifo : tête qui fait le tour de l'anneau, croissance (x2) pendant que la file est
+//   coupée en deux, placeIn() puis croissance sur le tas (l'arena ne grossit plus),
+//   copie sur le tas
+// - Memory::readBatch : lecture en deux segments à travers la fin du buffer circulaire,
+//   sur le tas puis dans une arena, et après écrasement des plus anciennes valeurs
+// ======================================================================================
+
+static bool aligned(const void* p, std::size_t align) {
+    return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+
+// Contenu de la file depuis la tête
+template <typename T>
+static std::vector<T> items(const Fifo<T>& fifo) {
+    std::vector<T> out;
+    for (std::size_t i = 0; i < fifo.size(); ++i) out.push_back(fifo[i]);
+    return out;
+}
+
+struct Tracked {
+    std::vector<int>* log;
+    int id;
+    Tracked(std::vector<int>* l, int i) : log(l), id(i) {}
+    ~Tracked() { log->push_back(id); }
+};
+
+int main() {
+    std::cout << "TESTARENA: start\n";
+    bool ok = true;
+
+    // ---------------- Arena ----------------
+    {
+        Arena arena(64);
+        void* a = arena.allocate(1, 1);
+        void* b = arena.allocate(8, 8);
+        void* c = arena.allocate(3, 1);
+        void* d = arena.allocate(16, 16);
+        ok &= aligned(b, 8) && aligned(d, 16);
+        ok &= static_cast<char*>(b) - static_cast<char*>(a) == 8; // 7 octets de padding
+        ok &= static_cast<char*>(d) - static_cast<char*>(c) == 16; // c en 16, d en 32
+        ok &= arena.bytesUsed() == 48 && arena.bytesReserved() == 64;
+
+        // Plus de place dans le bloc : nouveau bloc de 64 octets
+        void* e = arena.allocate(32, 8);
+        ok &= aligned(e, 8) && arena.bytesReserved() == 128 && arena.bytesUsed() == 80;
+        // Plus grande qu'un bloc : bloc dédié à sa taille
+        void* f = arena.allocate(200, 8);
+        ok &= aligned(f, 8) && arena.bytesReserved() == 328 && arena.bytesUsed() == 280;
+
+        double* values = arena.allocateArray<double>(3);
+        ok &= aligned(values, alignof(double)) && values[0] == 0.0 && values[2] == 0.0;
+        std::cout << "  arena: " << arena.bytesUsed() << " bytes used / " << arena.bytesReserved() << " reserved\n";
+    }
+    {
+        std::vector<int> destroyed;
+        {
+            Arena arena(32);
+            for (int i = 0; i < 4; ++i) arena.make<Tracked>(&destroyed, i); // sur plusieurs blocs
+        }
+        ok &= destroyed == std::vector<int>({3, 2, 1, 0});
+    }
+
+    // ---------------- Fifo ----------------
+    {
+        Fifo<int> fifo;
+        for (int i = 0; i < 3; ++i) fifo.push(i);
+        fifo.pop();
+        fifo.pop();
+        for (int i = 3; i < 6; ++i) fifo.push(i); // capacité 4 : la tête est en 2, la queue a fait le tour
+        ok &= fifo.size() == 4 && fifo.front() == 2 && items(fifo) == std::vector<int>({2, 3, 4, 5});
+
+        fifo.push(6); // croissance pendant que la file est coupée en deux
+        ok &= items(fifo) == std::vector<int>({2, 3, 4, 5, 6});
+        for (int expected = 2; expected <= 6; ++expected) {
+            ok &= fifo.front() == expected;
+            fifo.pop();
+        }
+        ok &= fifo.empty();
+
+        // Plusieurs tours complets de l'anneau (capacité 8) sans croissance
+        for (int i = 0; i < 100; ++i) {
+            fifo.push(i);
+            if (fifo.size() > 4) {
+                ok &= fifo.front() == i - 4;
+                fifo.pop();
+            }
+        }
+        ok &= items(fifo) == std::vector<int>({96, 97, 98, 99});
+        std::cout << "  fifo: wraparound and growth keep order\n";
+    }
+    {
+        Arena arena(256);
+        Fifo<int> fifo;
+        for (int i = 0; i < 3; ++i) fifo.push(i);
+        fifo.pop();
+        std::size_t before = arena.bytesUsed();
+        fifo.placeIn(arena, 8);
+        ok &= arena.bytesUsed() == before + 8 * sizeof(int) && items(fifo) == std::vector<int>({1, 2});
+        for (int i = 3; i < 12; ++i) fifo.push(i); // 11 éléments : croissance à 16 sur le tas
+        ok &= arena.bytesUsed() == before + 8 * sizeof(int) && fifo.size() == 11 && fifo.front() == 1;
+        ok &= fifo[10] == 11;
+        for (int i = 12; i < 40; ++i) fifo.push(i); // puis 32 et 64, toujours hors de l'arena
+        ok &= arena.bytesUsed() == before + 8 * sizeof(int) && fifo.size() == 39 && fifo[38] == 39;
+
+        Fifo<int> copy(fifo);
+        ok &= arena.bytesUsed() == before + 8 * sizeof(int) && items(copy) == items(fifo);
+        copy.pop();
+        ok &= fifo.front() == 1 && copy.front() == 2;
+        std::cout << "  fifo in arena: " << arena.bytesUsed() - before << " bytes\n";
+    }
+
+    // ---------------- Memory::readBatch ----------------
+    for (bool inArena : {false, true}) {
+        Arena arena;
+        Memory mem("Ring");
+        mem.setSize(8);
+        if (inArena) mem.placeIn(arena);
+        value_t out[16];
+        for (int i = 0; i < 6; ++i) mem.pushValue(DataValue(i, true));
+        ok &= mem.readBatch(out, 5) == 5 && Value::toDouble(out[4]) == 4.0;
+
+        // tête en 5 : 7 valeurs, 3 avant la fin du buffer et 4 au début
+        for (int i = 6; i < 12; ++i) mem.pushValue(DataValue(i, true));
+        ok &= mem.getCount() == 7;
+        ok &= mem.readBatch(out, 2) == 2 && Value::toDouble(out[0]) == 5.0 && Value::toDouble(out[1]) == 6.0;
+        std::size_t n = mem.readBatch(out, 16);
+        ok &= n == 5 && mem.getCount() == 0;
+        for (std::size_t i = 0; i < n; ++i) ok &= Value::toDouble(out[i]) == 7.0 + static_cast<double>(i);
+
+        // Buffer plein puis écrasé : les 8 valeurs les plus récentes, dans l'ordre
+        for (int i = 0; i < 11; ++i) mem.pushValue(DataValue(100 + i, true));
+        n = mem.readBatch(out, 16);
+        ok &= n == 8;
+        for (std::size_t i = 0; i < n; ++i) ok &= Value::toDouble(out[i]) == 103.0 + static_cast<double>(i);
+        ok &= mem.readBatch(out, 4) == 0;
+        std::cout << "  memory readBatch across wrap (" << (inArena ? "arena" : "heap") << ")\n";
+    }
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
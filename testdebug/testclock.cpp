@@ -0,0 +1,85 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "clock.h"
+
+// ======================================================================================
+//                           TEST CLOCK
+// Procédure :
+// Analyse des valeurs de CLOCK valides et invalides
+// Vérifie les fronts d'horloges P PHASE et N/D PHASE sur quelques cycles
+// Vérifie la composition (sous-plateforme) et la conversion cycle propre -> cycle de base
+// ======================================================================================
+
+static std::string pattern(const ClockChain& chain, int n) {
+    std::string s;
+    for (int t = 0; t < n; ++t) s += chain.edgesAt(static_cast<std::uint64_t>(t)) ? '1' : '0';
+    return s;
+}
+
+static std::string pattern(const Clock& c, int n) {
+    ClockChain chain;
+    chain.push(c);
+    return pattern(chain, n);
+}
+
+int main() {
+    std::cout << "TESTCLOCK: start\n";
+    bool ok = true;
+
+    struct Case { const char* spec; const char* expected; };
+    const std::vector<Case> cases = {
+        {"1", "111111111111"},
+        {"4", "100010001000"},
+        {"4 1", "010001000100"},
+        {"2/4 1", "010101010101"},
+        {"2/3", "101101101101"},
+        {"3/5 2", "011010110101"},
+    };
+    for (const Case& c : cases) {
+        Clock clock;
+        if (!clock.parse(c.spec)) {
+            std::cerr << "CLOCK '" << c.spec << "' rejected\n";
+            ok = false;
+            continue;
+        }
+        std::string got = pattern(clock, 12);
+        std::cout << " CLOCK: " << c.spec << " -> " << clock.toString() << " edges " << got << "\n";
+        if (got != c.expected) {
+            std::cerr << "  expected " << c.expected << "\n";
+            ok = false;
+        }
+    }
+
+    for (const char* bad : {"0", "4 4", "x", "3/0", "3/2", "2/3 1 5", "-1"}) {
+        Clock clock;
+        if (clock.parse(bad)) {
+            std::cerr << "CLOCK '" << bad << "' accepted\n";
+            ok = false;
+        }
+    }
+
+    // Sous-plateforme CLOCK: 2 contenant un composant CLOCK: 3 1 -> un front tous les 6 cycles, au cycle 2
+    Clock outer, inner;
+    outer.parse("2");
+    inner.parse("3 1");
+    ClockChain chain;
+    chain.push(outer);
+    chain.push(inner);
+    std::string got = pattern(chain, 14);
+    std::cout << " CLOCK: 2 then 3 1 -> edges " << got << "\n";
+    if (got != "00100000100000") ok = false;
+    for (std::uint64_t k = 0; k < 20; ++k) {
+        std::uint64_t t = chain.cycleOfTick(k);
+        if (chain.ticks(t) != k || chain.ticks(t + 1) != k + 1) {
+            std::cerr << "cycleOfTick(" << k << ") = " << t << " is not the edge of tick " << k << "\n";
+            ok = false;
+            break;
+        }
+    }
+    if (chain.cycleOfTick(UINT64_MAX) != UINT64_MAX) ok = false;
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "simulation.h"
+#include "platform.h"
+
+// ======================================================================================
+//                           TEST CONFIG (ConfigCache)
+// Procédure :
+// - un fichier n'est lu qu'une fois : réécrit après le premier accès, le cache garde
+//   l'ancien contenu ; deux fichiers identiques partagent le même ConfigFile / programme
+// - prefetch() descend dans une sous-plateforme sans TYPE (nom du fichier), comme le
+//   chargement, et met en cache ses composants et programmes
+// - data/platformT.txt chargée avec prefetch sur 8 threads puis sur 1 thread (cache
+//   vidé entre les deux) : même image binaire, même flot DISPLAY
+// ======================================================================================
+
+static std::string dir;
+
+static std::string write(const std::string& name, const std::string& content) {
+    std::string path = dir + "/" + name;
+    std::ofstream(path) << content;
+    return path;
+}
+
+static std::vector<value_t> stream(Simulation& sim, std::uint64_t cycles) {
+    std::vector<value_t> values;
+    sim.onOutput([&values](const Display&, const value_t* v, std::size_t n) { values.insert(values.end(), v, v + n); });
+    sim.step(cycles);
+    sim.onOutput(nullptr);
+    return values;
+}
+
+// Plateforme chargée avec n threads de prefetch, cache vidé au préalable
+static bool loadWith(unsigned threads, Simulation& sim, std::string& image) {
+    ConfigCache::clear();
+    ConfigCache::setThreads(threads);
+    return sim.load("data/platformT.txt") && sim.getPlatform().encodeImage(image);
+}
+
+int main() {
+    std::cout << "TESTCONFIG: start\n";
+    bool ok = true;
+
+    dir = "/tmp/testconfig_" + std::to_string(getpid());
+    mkdir(dir.c_str(), 0755);
+
+    // Lu une seule fois par chemin, partagé par contenu
+    std::string a = write("a_cpu.txt", "TYPE: CPU\nLABEL: Cached CPU\nFREQUENCY: 2\n");
+    std::string b = write("b_cpu.txt", "TYPE: CPU\nLABEL: Cached CPU\nFREQUENCY: 2\n");
+    auto first = ConfigCache::getConfig(a);
+    write("a_cpu.txt", "TYPE: CPU\nLABEL: Rewritten\n");
+    auto again = ConfigCache::getConfig(a);
+    ok &= first && again == first && first->get("LABEL") == "Cached CPU";
+    ok &= ConfigCache::getConfig(b) == first;
+    std::string p1 = write("p1.txt", "ADD 1 2\nMUL 3 4\n");
+    std::string p2 = write("p2.txt", "ADD 1 2\nMUL 3 4\n");
+    ok &= ConfigCache::getProgram(p1) && ConfigCache::getProgram(p1) == ConfigCache::getProgram(p2);
+    ok &= !ConfigCache::getConfig(dir + "/missing.txt") && ConfigCache::isCached(dir + "/missing.txt");
+    std::cout << "  cache: same path and same content share one entry\n";
+
+    // Prefetch à travers une sous-plateforme sans TYPE
+    std::string program = write("untyped_program.txt", "SUB 9 1\n");
+    std::string cpu = write("leaf_cpu.txt", "TYPE: CPU\nLABEL: Leaf CPU\nFREQUENCY: 1\nPROGRAM: " + program + "\n");
+    std::string sub = write("sub_platform_untyped.txt", "LABEL: Untyped box\nCOMPONENT: " + cpu + "\n");
+    std::string root = write("root.txt", "TYPE: PLATFORM\nLABEL: Root\nCOMPONENT: " + sub + "\n");
+    ConfigCache::prefetch(root);
+    ok &= ConfigCache::isCached(sub) && ConfigCache::isCached(cpu);
+    ok &= ConfigCache::componentType(sub) == "PLATFORM";
+    std::cout << "  prefetch: untyped sub-platform " << (ConfigCache::isCached(cpu) ? "followed" : "NOT followed") << "\n";
+
+    // Prefetch parallèle puis chargement = chargement série
+    Simulation parallel, serial;
+    std::string parallelImage, serialImage;
+    ok &= loadWith(8, parallel, parallelImage);
+    ok &= loadWith(1, serial, serialImage);
+    ok &= !parallelImage.empty() && parallelImage == serialImage;
+    std::vector<value_t> out = stream(parallel, 100);
+    ok &= !out.empty() && out == stream(serial, 100);
+    std::cout << "  platformT: " << parallelImage.size() << " image bytes, " << out.size()
+              << " values, parallel " << (parallelImage == serialImage ? "==" : "!=") << " serial\n";
+    ConfigCache::setThreads(0);
+
+    for (const std::string& path : {a, b, p1, p2, program, cpu, sub, root}) std::remove(path.c_str());
+    rmdir(dir.c_str());
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
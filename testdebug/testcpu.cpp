@@ -1,4 +1,5 @@
 #include "cpu.h"
+#include "config.h"
 #include <iostream>
 #include <fstream>
 #include <cassert>
@@ -194,6 +195,46 @@ void testDivisionByZero() {
     std::cout << "Test division par zéro reussi!" << std::endl;
 }
 
+// Test 6: Programmes partagés entre CPU
+void testSharedProgram() {
+    std::cout << "\n=== Test 6: Programmes partages ===" << std::endl;
+
+    createTestProgram("shared_program.txt");
+    // Mêmes instructions, écrites autrement
+    std::ofstream file("shared_program_alt.txt");
+    file << "ADD 5 3\nSUB 10 2\nMUL 4 2.5\nDIV 8 2\nADD 1 1\n";
+    file.close();
+
+    std::size_t before = ConfigCache::programCount();
+    CPU a, b, c;
+    a.loadProgram("shared_program.txt");
+    b.loadProgram("shared_program.txt");
+    c.loadProgram("shared_program_alt.txt");
+    Program copy = a.getProgram();
+    Program decoded;
+    decoded.assign(a.getProgram().begin(), a.getProgram().size());
+
+    // Une seule image pour les cinq programmes
+    const auto& image = a.getProgram().getImage();
+    assert(image && image->size() == 5);
+    assert(b.getProgram().getImage() == image);
+    assert(c.getProgram().getImage() == image);
+    assert(copy.getImage() == image && decoded.getImage() == image);
+    assert(ConfigCache::programCount() <= before + 1);
+    std::cout << "Image partagee par " << image.use_count() << " references" << std::endl;
+
+    // Program counter propre à chaque programme
+    a.getProgram().compute();
+    a.getProgram().compute();
+    double first = b.getProgram().compute().compute();
+    std::cout << "Premiere instruction de b apres deux de a: " << first << " (attendu: 8.0)" << std::endl;
+    assert(first == 8.0);
+
+    remove("shared_program.txt");
+    remove("shared_program_alt.txt");
+    std::cout << "Test programmes partages reussi!" << std::endl;
+}
+
 int main() {
     std::cout << "=== Debut du Testbench CPU ===" << std::endl;
     
@@ -203,6 +244,7 @@ int main() {
         testProgram();
         testCPU();
         testDivisionByZero();
+        testSharedProgram();
         
         std::cout << "\n Tous les tests ont ete passes avec succes!" << std::endl;
         
@@ -0,0 +1,167 @@
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simulation.h"
+#include "platform.h"
+#include "livestats.h"
+
+// ======================================================================================
+//                           TEST LIVESTATS
+// Procédure :
+// data/platformA.txt publiée dans un segment POSIX, relu comme simtop (shm_open, mmap
+// en lecture seule, copie validée par le seqlock) :
+// - en-tête (magic, version, pid, cycles prévus), une entrée par composant dans l'ordre
+//   de simulate() avec son type et son label
+// - après update() : cycle, occupation des buffers et compteurs produced/consumed
+// - un lecteur en parallèle de 2000 update() : chaque copie validée correspond
+//   exactement à l'état publié pour son cycle (jamais un mélange de deux update())
+// - le segment disparaît avec LiveStats
+// ======================================================================================
+
+struct Row {
+    std::string type, label;
+    std::uint64_t produced, consumed, occupancy;
+    bool operator==(const Row&) const = default;
+};
+
+struct Snapshot {
+    std::uint64_t cycle{0};
+    std::vector<Row> rows;
+};
+
+static Snapshot readSnapshot(const live::Segment* seg) {
+    Snapshot snap;
+    for (;;) {
+        std::uint64_t s1 = seg->seq.load(std::memory_order_acquire);
+        if (s1 & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        snap.cycle = seg->cycle.load(std::memory_order_relaxed);
+        snap.rows.resize(seg->n_entries);
+        for (std::uint32_t i = 0; i < seg->n_entries; ++i) {
+            const live::Entry& e = seg->entries[i];
+            snap.rows[i].type.assign(e.type, strnlen(e.type, sizeof(e.type)));
+            snap.rows[i].label.assign(e.label, strnlen(e.label, sizeof(e.label)));
+            snap.rows[i].produced = e.produced.load(std::memory_order_relaxed);
+            snap.rows[i].consumed = e.consumed.load(std::memory_order_relaxed);
+            snap.rows[i].occupancy = e.occupancy.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seg->seq.load(std::memory_order_relaxed) == s1) return snap;
+    }
+}
+
+// État attendu dans le segment, relevé directement sur les composants
+static std::vector<Row> expected(Platform& platform) {
+    std::vector<Row> rows;
+    platform.forEachComponent([&rows](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        Row row{"", "", 0, 0, 0};
+        if constexpr (std::is_same_v<T, CPU>) {
+            row = {"CPU", c.getLabel(), 0, 0, c.getRegisterDepth()};
+        } else if constexpr (std::is_same_v<T, BUS>) {
+            row = {"BUS", c.getLabel(), 0, 0, c.getReadySize() + c.getPendingSize()};
+        } else if constexpr (std::is_same_v<T, Memory>) {
+            row = {"MEMORY", c.getLabel(), 0, 0, c.getCount()};
+        } else if constexpr (std::is_same_v<T, Display>) {
+            row = {"DISPLAY", "<- " + c.getSourceLabel(), 0, 0, 0};
+        } else {
+            return;
+        }
+#ifdef PROJC_STATS
+        row.produced = c.getStats().produced;
+        row.consumed = c.getStats().consumed;
+#endif
+        rows.push_back(row);
+    });
+    return rows;
+}
+
+int main() {
+    std::cout << "TESTLIVESTATS: start\n";
+    bool ok = true;
+
+    const std::string name = "/testlivestats_" + std::to_string(getpid());
+    const std::uint64_t updates = 2000;
+    Simulation sim;
+    ok &= sim.load("data/platformA.txt");
+    sim.onOutput([](const Display&, const value_t*, std::size_t) {});
+    {
+        LiveStats stats(sim.getPlatform(), name, 1, updates + 50);
+        ok &= stats.isOpen();
+
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        struct stat st;
+        ok &= fd >= 0 && fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(live::Segment);
+        void* map = ok ? mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+        if (fd >= 0) close(fd);
+        ok &= map != MAP_FAILED;
+        if (!ok) {
+            std::cout << "TEST FAIL\n";
+            return 1;
+        }
+        const live::Segment* seg = static_cast<const live::Segment*>(map);
+
+        // En-tête et entrées
+        ok &= std::memcmp(seg->magic, live::MAGIC, sizeof(live::MAGIC)) == 0 && seg->version == live::VERSION;
+        ok &= seg->pid == static_cast<std::uint64_t>(getpid()) && seg->totalCycles.load() == updates + 50;
+        ok &= seg->n_entries == 4 && readSnapshot(seg).rows == expected(sim.getPlatform());
+
+        // Une publication
+        sim.step(50);
+        stats.update(sim.getCycle());
+        Snapshot snap = readSnapshot(seg);
+        ok &= snap.cycle == 50 && snap.rows == expected(sim.getPlatform());
+#ifdef PROJC_STATS
+        ok &= snap.rows[0].produced > 0 && snap.rows[1].consumed > 0;
+#endif
+        std::cout << "  cycle 50: " << snap.rows.size() << " entries, " << snap.rows[0].label << " produced "
+                  << snap.rows[0].produced << "\n";
+
+        // Lecteur concurrent : chaque copie validée est l'état d'un seul update()
+        std::vector<std::vector<Row>> published(updates + 51);
+        std::vector<Snapshot> seen;
+        std::atomic<bool> done{false};
+        std::atomic<std::size_t> reads{0};
+        std::thread reader([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                seen.push_back(readSnapshot(seg));
+                reads.fetch_add(1, std::memory_order_release);
+            }
+        });
+        while (reads.load(std::memory_order_acquire) == 0) std::this_thread::yield();
+        for (std::uint64_t i = 0; i < updates; ++i) {
+            sim.step(1);
+            published[sim.getCycle()] = expected(sim.getPlatform());
+            stats.update(sim.getCycle());
+        }
+        done.store(true, std::memory_order_release);
+        reader.join();
+
+        std::size_t consistent = 0;
+        for (const Snapshot& s : seen) {
+            bool match = s.cycle == 50 ? s.rows == snap.rows : s.rows == published[s.cycle];
+            consistent += match;
+        }
+        std::cout << "  concurrent reader: " << consistent << "/" << seen.size() << " consistent snapshots\n";
+        ok &= !seen.empty() && consistent == seen.size();
+        munmap(map, static_cast<std::size_t>(st.st_size));
+    }
+
+    // Segment supprimé par ~LiveStats
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    ok &= fd < 0;
+    if (fd >= 0) close(fd);
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "platform.h"
+#include "partition.h"
+
+// ======================================================================================
+//                           TEST PARTITION (PartitionedRun)
+// Procédure :
+// Plateforme écrite dans un répertoire temporaire, trois groupes indépendants :
+//   sous-plateforme data/platformP.txt (Producer box, OUTPUT DRAM 1)
+//   sous-plateforme data/platformB.txt (Coproc -> Auxiliary bus -> DRAM 2 -> DISPLAY)
+//   racine : BUS (Producer box) -> MEMORY -> DISPLAY, BUS (Coproc) -> MEMORY -> DISPLAY
+// Simulée en un seul processus, puis répartie sur 2 et 3 partitions (BUS coupés en
+// mémoire partagée, sorties recopiées dans un flux) : même suite de lignes DISPLAY pour
+// chaque source, rien d'écrit sur la console par les partitions
+// ======================================================================================
+
+static std::string dir;
+
+static std::string write(const std::string& name, const std::string& content) {
+    std::string path = dir + "/" + name;
+    std::ofstream(path) << content;
+    return path;
+}
+
+// Lignes [DISPLAY] par source (les partitions regroupent leurs sorties : seul l'ordre
+// par DISPLAY est comparable)
+static std::map<std::string, std::vector<std::string>> displayLines(const std::string& text) {
+    std::map<std::string, std::vector<std::string>> lines;
+    std::istringstream in(text);
+    const std::string prefix = "[DISPLAY] Source: ";
+    for (std::string line; std::getline(in, line);) {
+        if (line.rfind(prefix, 0) != 0) continue;
+        std::size_t arrow = line.find(" -> ");
+        lines[line.substr(prefix.size(), arrow - prefix.size())].push_back(line);
+    }
+    return lines;
+}
+
+int main() {
+    std::cout << "TESTPARTITION: start\n";
+    bool ok = true;
+
+    dir = "/tmp/testpartition_" + std::to_string(getpid());
+    mkdir(dir.c_str(), 0755);
+    std::vector<std::string> files = {
+        write("link_bus.txt", "TYPE: BUS\nLABEL: Link bus\nWIDTH: 3\nSOURCE: Producer box\n"),
+        write("far_mem.txt", "TYPE: MEMORY\nLABEL: Far mem\nSIZE: 64\nACCESS: 3\nSOURCE: Link bus\n"),
+        write("far_display.txt", "TYPE: DISPLAY\nREFRESH: 6\nSOURCE: Far mem\n"),
+        write("coproc_bus.txt", "TYPE: BUS\nLABEL: Coproc link\nWIDTH: 2\nSOURCE: Coproc\n"),
+        write("coproc_mem.txt", "TYPE: MEMORY\nLABEL: Coproc mem\nSIZE: 16\nACCESS: 2\nSOURCE: Coproc link\n"),
+        write("coproc_display.txt", "TYPE: DISPLAY\nREFRESH: 5\nSOURCE: Coproc mem\n"),
+    };
+    std::string platform = "TYPE: PLATFORM\nLABEL: Split platform\n"
+                           "COMPONENT: data/platformP.txt\nCOMPONENT: data/platformB.txt\n";
+    for (const std::string& f : files) platform += "COMPONENT: " + f + "\n";
+    files.push_back(write("platform.txt", platform));
+
+    const std::uint64_t cycles = 200;
+    // Chargement comme simulator.cpp : les DISPLAY écrivent sur std::cout
+    Platform single("NotLoadedPlatform");
+    ok &= single.loadFromFile(files.back());
+    std::ostringstream singleOut;
+    std::streambuf* old = std::cout.rdbuf(singleOut.rdbuf());
+    single.run(cycles);
+    std::cout.rdbuf(old);
+    auto expected = displayLines(singleOut.str());
+    std::size_t total = 0;
+    for (const auto& [source, lines] : expected) total += lines.size();
+    std::cout << "  single process: " << expected.size() << " displays, " << total << " lines\n";
+    ok &= expected.size() == 3 && expected.count("Far mem") && expected.count("Coproc mem");
+
+    for (unsigned n : {2u, 3u}) {
+        Platform split("NotLoadedPlatform");
+        ok &= split.loadFromFile(files.back());
+        PartitionedRun partitioned(split, n);
+        std::ostringstream out;
+        bool ran = partitioned.run(cycles, out);
+        auto got = displayLines(out.str());
+        bool same = got == expected;
+        std::cout << "  " << partitioned.getPartitions() << " partitions, " << partitioned.getCutLinks()
+                  << " cut buses: " << (ran && same ? "identical" : "MISMATCH") << "\n";
+        ok &= ran && same && partitioned.getPartitions() == n && partitioned.getCutLinks() >= 1;
+    }
+
+    for (const std::string& f : files) std::remove(f.c_str());
+    rmdir(dir.c_str());
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "simulation.h"
+#include "platform.h"
+#include "image.h"
+
+// ======================================================================================
+//                           TEST PLATFORM (port OUTPUT)
+// Procédure :
+// data/platformP.txt : CPU -> BUS -> MEMORY, OUTPUT: DRAM 1
+// data/platformO.txt : platformP comme sous-plateforme, lue par un DISPLAY (SOURCE: Producer box)
+// Vérifie : le DISPLAY reçoit le même flot de valeurs que celui de data/platformA.txt
+// (sans BUS supplémentaire), read()/hasData()/readBatch() d'une plateforme transmis à
+// son OUTPUT, même sortie après clonage par image, image corrompue refusée, OUTPUT
+// inconnu refusé, type des COMPONENT lu dans le fichier (TYPE, nom en dernier recours,
+// image reconnue au magic)
+// ======================================================================================
+
+static std::vector<value_t> stream(Simulation& sim, std::uint64_t cycles, std::size_t* refreshes = nullptr) {
+    std::vector<value_t> values;
+    std::size_t lines = 0;
+    sim.onOutput([&](const Display&, const value_t* v, std::size_t n) {
+        values.insert(values.end(), v, v + n);
+        ++lines;
+    });
+    sim.step(cycles);
+    sim.onOutput(nullptr);
+    if (refreshes) *refreshes = lines;
+    return values;
+}
+
+int main() {
+    std::cout << "TESTPLATFORM: start\n";
+    bool ok = true;
+
+    // Flot de référence : même chaîne, DISPLAY dans la même plateforme
+    Simulation reference, composed;
+    ok &= reference.load("data/platformA.txt");
+    ok &= composed.load("data/platformO.txt");
+    std::vector<value_t> expected = stream(reference, 200);
+    std::size_t refreshes = 0;
+    std::vector<value_t> got = stream(composed, 200, &refreshes);
+    // Le DISPLAY de la racine est simulé avant la sous-plateforme : au plus un cycle de retard
+    bool prefix = !got.empty() && got.size() <= expected.size()
+               && std::equal(got.begin(), got.end(), expected.begin());
+    std::cout << "  composed: " << got.size() << " values in " << refreshes << " refreshes, reference "
+              << expected.size() << (prefix ? " (same stream)" : " MISMATCH") << "\n";
+    ok &= prefix && expected.size() - got.size() < 32;
+
+    // La plateforme est enregistrée sous son label et lisible comme un composant
+    std::vector<std::string> labels = composed.getLabels();
+    ok &= std::find(labels.begin(), labels.end(), "Producer box") != labels.end();
+
+    // Port d'une racine : lecture directe de la MEMORY interne
+    Simulation box;
+    ok &= box.load("data/platformP.txt");
+    box.step(20);
+    Platform& p = box.getPlatform();
+    ok &= p.getOutput() && p.getOutput()->getLabel() == "DRAM 1";
+    ok &= p.producer() == p.getOutput();
+    ok &= p.hasData() == box.hasData("DRAM 1");
+    DataValue first = p.read();
+    value_t batch[64];
+    std::size_t n = p.readBatch(batch, 64);
+    ok &= first.valid && n > 0 && !p.hasData() && !p.read().valid;
+    std::cout << "  port: first=" << first.value << " then " << n << " values in one batch\n";
+
+    // Clonage par image : port et liaison conservés
+    std::string image;
+    ok &= composed.getPlatform().encodeImage(image);
+    Simulation clone, fresh;
+    ok &= clone.loadImage(image, "platformO");
+    ok &= fresh.load("data/platformO.txt");
+    ok &= stream(clone, 100) == stream(fresh, 100);
+
+    // Image corrompue : racine qui n'est pas une plateforme, taille MEMORY négative
+    image::ImageHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    auto node = [&header](std::string& data, std::size_t i) {
+        return reinterpret_cast<image::ImageNode*>(&data[header.nodes_offset + i * sizeof(image::ImageNode)]);
+    };
+    std::string rootless = image, negative = image;
+    node(rootless, 0)->kind = image::NODE_CPU;
+    for (std::uint32_t i = 0; i < header.n_nodes; ++i) {
+        if (node(negative, i)->kind == image::NODE_MEMORY) node(negative, i)->p0 = -1;
+    }
+    Simulation corrupted;
+    corrupted.onLog([](LogLevel, const std::string&) {});
+    ok &= !corrupted.loadImage(rootless, "rootless") && !corrupted.loadImage(negative, "negative");
+
+    // OUTPUT qui ne désigne pas un composant direct : chargement refusé
+    const std::string badPath = "/tmp/testplatform_bad.txt";
+    {
+        std::ofstream bad(badPath);
+        bad << "TYPE: PLATFORM\nLABEL: Bad box\nCOMPONENT: data/cpu1.txt\nOUTPUT: Nowhere\n";
+    }
+    Simulation refused;
+    std::vector<std::string> logs;
+    refused.onLog([&logs](LogLevel, const std::string& message) { logs.push_back(message); });
+    ok &= !refused.load(badPath);
+    bool reported = false;
+    for (const std::string& m : logs) reported |= m.find("OUTPUT \"Nowhere\"") != std::string::npos;
+    ok &= reported;
+    std::remove(badPath.c_str());
+
+    // Type des COMPONENT : la ligne TYPE prime sur le nom du fichier, le nom ne sert que
+    // pour une config sans TYPE ; une image de plateforme est reconnue par son magic
+    const std::string misnamed = "/tmp/testplatform_cpu.txt";
+    const std::string untyped = "/tmp/testplatform_mem_untyped.txt";
+    const std::string subImage = "/tmp/testplatform_sub.img";
+    const std::string typedPath = "/tmp/testplatform_typed.txt";
+    {
+        std::ofstream(misnamed) << "TYPE: MEMORY\nLABEL: Misnamed mem\nSIZE: 8\nSOURCE: Main processing unit\n";
+        std::ofstream(untyped) << "LABEL: Untyped mem\nSIZE: 8\nSOURCE: Main processing unit\n";
+        std::ofstream(typedPath) << "TYPE: PLATFORM\nLABEL: Typed box\nCOMPONENT: data/cpu1.txt\nCOMPONENT: "
+                                 << misnamed << "\nCOMPONENT: " << untyped << "\nCOMPONENT: " << subImage << "\n";
+    }
+    ok &= box.getPlatform().saveImage(subImage);
+    Simulation typed;
+    ok &= typed.load(typedPath);
+    std::size_t cpus = 0, memories = 0, subplatforms = 0;
+    typed.getPlatform().forEachComponent([&](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<T, CPU>) ++cpus;
+        else if constexpr (std::is_same_v<T, Memory>) {
+            ++memories;
+            ok &= c.getLabel() != "Misnamed mem" || c.getSize() == 8;
+        } else if constexpr (std::is_same_v<T, Platform>) ++subplatforms;
+    });
+    labels = typed.getLabels();
+    ok &= std::find(labels.begin(), labels.end(), "Misnamed mem") != labels.end();
+    ok &= std::find(labels.begin(), labels.end(), "Untyped mem") != labels.end();
+    std::cout << "  typed: " << cpus << " CPU, " << memories << " MEMORY, " << subplatforms << " image subplatform\n";
+    // cpu1 + CPU de l'image ; 2 MEMORY ici + DRAM 1 de l'image
+    ok &= cpus == 2 && memories == 3 && subplatforms == 1;
+    for (const std::string& path : {misnamed, untyped, subImage, typedPath}) std::remove(path.c_str());
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
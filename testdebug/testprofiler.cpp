@@ -0,0 +1,82 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "simulation.h"
+#include "platform.h"
+#include "profiler.h"
+
+// ======================================================================================
+//                           TEST PROFILER
+// Procédure :
+// data/platformC.txt : sous-plateformes A platform (horloge de base) et Slow platform
+// (CLOCK 4), 100 cycles avec le profiler (steady_clock puis TSC) :
+// - une entrée par composant, chemin "Two clock domains/<sous-plateforme>"
+// - 100 appels pour A platform, 25 pour Slow platform (un par front), temps non nul
+// - même flot DISPLAY que sans profiler
+// - writeFolded : une ligne "Two clock domains;A platform;CPU <label> <ns>" par entrée
+// - writeTop : N lignes, puis l'agrégat par type
+// ======================================================================================
+
+static std::vector<value_t> run(Simulation& sim, Profiler* profiler) {
+    std::vector<value_t> values;
+    sim.load("data/platformC.txt");
+    sim.getPlatform().setProfiler(profiler);
+    sim.onOutput([&values](const Display&, const value_t* v, std::size_t n) { values.insert(values.end(), v, v + n); });
+    sim.step(100);
+    sim.onOutput(nullptr);
+    return values;
+}
+
+static std::size_t lines(const std::string& text) {
+    std::size_t n = 0;
+    for (char c : text) n += c == '\n';
+    return n;
+}
+
+int main() {
+    std::cout << "TESTPROFILER: start\n";
+    bool ok = true;
+
+    Simulation plain;
+    std::vector<value_t> expected = run(plain, nullptr);
+    ok &= !expected.empty();
+
+    for (auto source : {Profiler::ClockSource::STEADY, Profiler::ClockSource::TSC}) {
+        Profiler profiler(source);
+        Simulation sim;
+        ok &= run(sim, &profiler) == expected;
+
+        const auto& entries = profiler.getEntries();
+        std::size_t fast = 0, slow = 0;
+        for (const Profiler::Entry& e : entries) {
+            if (e.path == "Two clock domains/A platform") {
+                ++fast;
+                ok &= e.calls == 100;
+            } else if (e.path == "Two clock domains/Slow platform") {
+                ++slow;
+                ok &= e.calls == 25;
+            } else {
+                ok = false;
+            }
+            ok &= e.ticks > 0;
+        }
+        ok &= fast == 4 && slow == 4;
+
+        std::ostringstream folded, top;
+        profiler.writeFolded(folded);
+        profiler.writeTop(top, 3);
+        ok &= lines(folded.str()) == entries.size();
+        ok &= folded.str().find("Two clock domains;A platform;CPU Main processing unit ") != std::string::npos;
+        ok &= folded.str().find("Two clock domains;Slow platform;DISPLAY <- DRAM 2 ") != std::string::npos;
+        // En-tête + 3 lignes, puis en-tête + CPU, MEMORY, BUS, DISPLAY
+        ok &= lines(top.str()) == 2 + 3 + 2 + 4;
+        ok &= top.str().find("=== Profile: by component type ===") != std::string::npos;
+        std::cout << "  " << (source == Profiler::ClockSource::TSC ? "tsc" : "steady") << ": " << entries.size()
+                  << " entries (" << fast << " x 100 calls, " << slow << " x 25 calls)\n";
+    }
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
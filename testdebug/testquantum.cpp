@@ -0,0 +1,161 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simulation.h"
+#include "platform.h"
+
+// ======================================================================================
+//                           TEST QUANTUM (Platform::simulate(k))
+// Procédure :
+// Le quantum stepping n'est exact que si les sources d'un composant ne changent pas
+// pendant le quantum : chaque composant lit ici une MEMORY "réservoir" que rien d'autre
+// ne modifie, remplie par le test entre deux quanta
+//   Store D -> DISPLAY (REFRESH 5)
+//   Store M -> MEMORY (ACCESS 3, SIZE 8 : valeurs écrasées)
+//   Store B -> BUS (WIDTH 2)
+//   CPU (FREQUENCY 3, 2 coeurs)
+// Pour chaque quantum k de 1 à 10 (frontières au milieu des périodes ACCESS et REFRESH),
+// 100 cycles par simulate(k) contre 100 simulate() : mêmes sorties DISPLAY, même état
+// final, mêmes compteurs des composants testés (pour les réservoirs : données seulement,
+// et sans emptyReads pour celui du BUS, dont simulate(k) s'arrête de lire une source vide)
+// Puis skipCycles() au-delà de INT_MAX sur la MEMORY et le DISPLAY
+// ======================================================================================
+
+static std::string dir;
+
+static std::string write(const std::string& name, const std::string& content) {
+    std::string path = dir + "/" + name;
+    std::ofstream(path) << content;
+    return path;
+}
+
+// Remplissage des réservoirs, identique pour les deux simulations
+static void refill(Simulation& sim, std::uint64_t cycle) {
+    for (const char* label : {"Store D", "Store M", "Store B"}) {
+        auto* store = static_cast<Memory*>(sim.getPlatform().getRegistry().find(label));
+        for (int i = 0; i < 3; ++i) store->pushValue(DataValue(static_cast<double>(cycle * 10 + i), true));
+    }
+}
+
+// État final et compteurs. Un réservoir est vidé par son lecteur pendant le quantum,
+// après son propre simulate(k) : seuls ses compteurs de données sont comparés (son
+// occupation relevée pendant le quantum ne peut pas voir ces lectures)
+static std::string state(Simulation& sim) {
+    std::string s;
+    sim.getPlatform().forEachComponent([&s](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        bool store = false;
+        if constexpr (std::is_same_v<T, CPU>) s += c.getLabel() + " reg=" + std::to_string(c.getRegisterDepth());
+        else if constexpr (std::is_same_v<T, BUS>) s += c.getLabel() + " ready=" + std::to_string(c.getReadySize())
+                                                      + " pending=" + std::to_string(c.getPendingSize());
+        else if constexpr (std::is_same_v<T, Memory>) {
+            s += c.getLabel() + " count=" + std::to_string(c.getCount());
+            store = c.getLabel().rfind("Store", 0) == 0;
+        } else {
+            return;
+        }
+#ifdef PROJC_STATS
+        const ComponentStats& st = c.getStats();
+        s += " produced=" + std::to_string(st.produced) + " consumed=" + std::to_string(st.consumed)
+           + " dropped=" + std::to_string(st.dropped);
+        if (!store) {
+            s += " stall=" + std::to_string(st.stallCycles) + " samples=" + std::to_string(st.samples)
+               + " occupancy=" + std::to_string(st.occupancySum) + " peak=" + std::to_string(st.peakOccupancy);
+        }
+        if constexpr (!std::is_same_v<T, Display>) {
+            if (c.getLabel() != "Store B") s += " empty=" + std::to_string(st.emptyReads);
+        }
+#endif
+        (void)store;
+        s += "\n";
+    });
+    return s;
+}
+
+int main() {
+    std::cout << "TESTQUANTUM: start\n";
+    bool ok = true;
+
+    dir = "/tmp/testquantum_" + std::to_string(getpid());
+    mkdir(dir.c_str(), 0755);
+    std::vector<std::string> files = {
+        write("store_d.txt", "TYPE: MEMORY\nLABEL: Store D\nSIZE: 256\n"),
+        write("store_m.txt", "TYPE: MEMORY\nLABEL: Store M\nSIZE: 256\n"),
+        write("store_b.txt", "TYPE: MEMORY\nLABEL: Store B\nSIZE: 256\n"),
+        write("cpu.txt", "TYPE: CPU\nLABEL: Quantum CPU\nCORES: 2\nFREQUENCY: 3\nPROGRAM: data/program2.txt\n"),
+        write("mem.txt", "TYPE: MEMORY\nLABEL: Slow mem\nSIZE: 8\nACCESS: 3\nSOURCE: Store M\n"),
+        write("bus.txt", "TYPE: BUS\nLABEL: Narrow bus\nWIDTH: 2\nSOURCE: Store B\n"),
+        write("display.txt", "TYPE: DISPLAY\nREFRESH: 5\nSOURCE: Store D\n"),
+    };
+    std::string platform = "TYPE: PLATFORM\nLABEL: Quantum platform\n";
+    for (const std::string& f : files) platform += "COMPONENT: " + f + "\n";
+    files.push_back(write("platform.txt", platform));
+
+    const std::uint64_t cycles = 100;
+    for (std::uint64_t k = 1; k <= 10; ++k) {
+        Simulation single, quantum;
+        ok &= single.load(files.back()) && quantum.load(files.back());
+        quantum.getPlatform().setQuantum(k);
+        std::vector<value_t> expected, got;
+        std::size_t refreshes[2] = {0, 0};
+        single.onOutput([&](const Display&, const value_t* v, std::size_t n) {
+            expected.insert(expected.end(), v, v + n);
+            ++refreshes[0];
+        });
+        quantum.onOutput([&](const Display&, const value_t* v, std::size_t n) {
+            got.insert(got.end(), v, v + n);
+            ++refreshes[1];
+        });
+
+        for (std::uint64_t done = 0; done < cycles;) {
+            refill(single, done);
+            refill(quantum, done);
+            std::uint64_t step = std::min(k, cycles - done);
+            for (std::uint64_t i = 0; i < step; ++i) single.step(1);
+            quantum.step(step); // Platform::run : un simulate(step)
+            done += step;
+        }
+
+        bool same = expected == got && refreshes[0] == refreshes[1] && state(single) == state(quantum);
+        std::cout << "  quantum " << k << ": " << refreshes[1] << " refreshes, " << got.size() << " values"
+                  << (same ? "" : " MISMATCH") << "\n";
+        if (!same) std::cout << state(single) << "--\n" << state(quantum);
+        ok &= same && !expected.empty();
+    }
+
+    // Sauts plus longs qu'un int : la phase ACCESS est conservée, le rafraîchissement
+    // atteint reste dû au prochain cycle
+    {
+        Simulation sim;
+        ok &= sim.load(files.back());
+        refill(sim, 0);
+        const std::uint64_t skip = 3'000'000'000ULL; // multiple de ACCESS 3
+        bool kept = true;
+        sim.getPlatform().forEachComponent([&](auto& c) {
+            using T = std::decay_t<decltype(c)>;
+            if constexpr (std::is_same_v<T, Memory>) {
+                if (c.getLabel() != "Slow mem") return;
+                std::uint64_t before = c.nextWakeup(0);
+                c.skipCycles(skip);
+                c.skipCycles(skip + 1);
+                kept &= before == 3 && c.nextWakeup(0) == 2;
+            } else if constexpr (std::is_same_v<T, Display>) {
+                c.skipCycles(skip);
+                kept &= c.nextWakeup(0) == 1;
+            }
+        });
+        std::cout << "  skip " << skip << " cycles: " << (kept ? "phase kept" : "MISMATCH") << "\n";
+        ok &= kept;
+    }
+
+    for (const std::string& f : files) std::remove(f.c_str());
+    rmdir(dir.c_str());
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simulation.h"
+#include "platform.h"
+#include "reload.h"
+
+// ======================================================================================
+//                           TEST RELOAD
+// Procédure :
+// Plateforme CPU -> BUS -> MEMORY -> DISPLAY écrite dans un répertoire temporaire
+// Après 50 cycles, les fichiers du BUS et de la MEMORY sont réécrits (WIDTH, SIZE) :
+// vérifie que poll() applique les deux paramètres sans perdre les données de la MEMORY
+// Vérifie qu'un changement de SOURCE est signalé et ignoré, que request() relit tout
+// sans rien changer, et qu'en idle skipping un DISPLAY endormi avec l'ancien REFRESH
+// est réveillé selon le nouveau
+// ======================================================================================
+
+static std::string dir;
+
+static void write(const std::string& name, const std::string& content) {
+    std::ofstream(dir + "/" + name) << content;
+}
+
+static void writePlatform(int refresh) {
+    write("cpu.txt", "TYPE: CPU\nLABEL: Reload CPU\nCORES: 4\nFREQUENCY: 5\nPROGRAM: data/program2.txt\n");
+    write("bus.txt", "TYPE: BUS\nLABEL: Reload bus\nWIDTH: 4\nSOURCE: Reload CPU\n");
+    write("mem.txt", "TYPE: MEMORY\nLABEL: Reload mem\nSIZE: 32\nACCESS: 2\nSOURCE: Reload bus\n");
+    write("display.txt", "TYPE: DISPLAY\nREFRESH: " + std::to_string(refresh) + "\nSOURCE: Reload mem\n");
+    write("platform.txt", "TYPE: PLATFORM\nLABEL: Reload platform\nCOMPONENT: " + dir + "/cpu.txt\nCOMPONENT: "
+                          + dir + "/bus.txt\nCOMPONENT: " + dir + "/mem.txt\nCOMPONENT: " + dir + "/display.txt\n");
+}
+
+int main() {
+    std::cout << "TESTRELOAD: start\n";
+    bool ok = true;
+
+    dir = "/tmp/testreload_" + std::to_string(getpid());
+    mkdir(dir.c_str(), 0755);
+    writePlatform(1000);
+
+    std::vector<std::string> logs;
+    Log::Sink collect = [&logs](LogLevel, const std::string& message) { logs.push_back(message); };
+    Log::Scope scope(&collect);
+
+    Simulation sim;
+    std::size_t refreshes = 0;
+    sim.onOutput([&refreshes](const Display&, const value_t*, std::size_t) { ++refreshes; });
+    ok &= sim.load(dir + "/platform.txt");
+    Platform& platform = sim.getPlatform();
+    platform.setIdleSkipping(true);
+
+    HotReload reload(platform);
+    std::cout << "  watching " << reload.fileCount() << " files (inotify " << (reload.isWatching() ? "on" : "off") << ")\n";
+    ok &= reload.isWatching() && reload.fileCount() == 4;
+
+    sim.step(50);
+    ok &= reload.poll() == 0;
+
+    auto* bus = static_cast<BUS*>(platform.getRegistry().find("Reload bus"));
+    auto* mem = static_cast<Memory*>(platform.getRegistry().find("Reload mem"));
+    std::size_t buffered = mem->getCount();
+
+    // Deux paramètres modifiés, données de la MEMORY conservées
+    write("bus.txt", "TYPE: BUS\nLABEL: Reload bus\nWIDTH: 8\nSOURCE: Reload CPU\n");
+    write("mem.txt", "TYPE: MEMORY\nLABEL: Reload mem\nSIZE: 64\nACCESS: 2\nSOURCE: Reload bus\n");
+    std::size_t applied = reload.poll();
+    std::cout << "  applied " << applied << " parameters, width=" << bus->getWidth() << " size=" << mem->getSize()
+              << " buffered " << buffered << " -> " << mem->getCount() << "\n";
+    ok &= applied == 2 && bus->getWidth() == 8 && mem->getSize() == 64 && mem->getCount() == buffered;
+
+    // DISPLAY endormi jusqu'au cycle 1000 : le nouveau REFRESH le réveille tout de suite
+    std::size_t before = refreshes;
+    write("display.txt", "TYPE: DISPLAY\nREFRESH: 2\nSOURCE: Reload bus\n");
+    logs.clear();
+    ok &= reload.poll() == 1;
+    bool warned = false;
+    for (const std::string& m : logs) warned |= m.find("SOURCE changed") != std::string::npos;
+    ok &= warned;
+    sim.step(20);
+    std::cout << "  refreshes in 20 cycles after REFRESH 1000 -> 2: " << refreshes - before << "\n";
+    ok &= refreshes - before == 10;
+
+    // Relecture de tout : rien n'a changé
+    HotReload::request();
+    ok &= reload.poll() == 0;
+
+    for (const char* name : {"cpu.txt", "bus.txt", "mem.txt", "display.txt", "platform.txt"}) {
+        std::remove((dir + "/" + name).c_str());
+    }
+    rmdir(dir.c_str());
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
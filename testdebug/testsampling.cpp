@@ -0,0 +1,81 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cmath>
+
+#include "platform.h"
+#include "sampling.h"
+
+// ======================================================================================
+//                           TEST SAMPLING
+// Procédure :
+// Analyse des valeurs de --sample valides et invalides
+// Charge data/platformA.txt (CPU -> BUS -> MEMORY -> DISPLAY)
+// Simulation échantillonnée de 20000 cycles, une fenêtre de 100 cycles tous les 2000
+// Vérifie : nombre de fenêtres et de cycles détaillés, bannière par fenêtre, débit du CPU
+// égal à celui lu par le BUS (au plus WIDTH), intervalles de confiance finis
+// ======================================================================================
+
+int main() {
+    std::cout << "TESTSAMPLING: start\n";
+    bool ok = true;
+
+    std::uint64_t period = 0, window = 0, warmup = 0;
+    if (!SampledRun::parse("2000:100:20", period, window, warmup) || period != 2000 || window != 100 || warmup != 20) {
+        std::cerr << "2000:100:20 rejected or misread\n";
+        ok = false;
+    }
+    for (const char* bad : {"100", "100:0", "100:200", "100:90:20", "a:b", "100:10:5:1", ":10"}) {
+        if (SampledRun::parse(bad, period, window, warmup)) {
+            std::cerr << "'" << bad << "' accepted\n";
+            ok = false;
+        }
+    }
+
+    Platform platform;
+    if (!platform.loadFromFile("data/platformA.txt")) {
+        std::cerr << "FAILED to load data/platformA.txt\n";
+        return 2;
+    }
+
+    // Les affichages ne viennent que des fenêtres détaillées
+    SampledRun sampled(platform, 2000, 100, 20);
+    std::ostringstream captured;
+    std::streambuf* old = std::cout.rdbuf(captured.rdbuf());
+    sampled.run(20000);
+    std::cout.rdbuf(old);
+
+    std::size_t banners = 0, lines = 0;
+    std::istringstream in(captured.str());
+    for (std::string line; std::getline(in, line);) {
+        if (line.rfind("=== Window", 0) == 0) ++banners;
+        else if (line.rfind("[DISPLAY]", 0) == 0) ++lines;
+    }
+    std::cout << " windows=" << sampled.getWindows() << " banners=" << banners << " display lines=" << lines
+              << " detailed=" << sampled.getDetailedCycles() << "\n";
+    if (sampled.getWindows() != 10 || banners != 10 || sampled.getDetailedCycles() != 1200) {
+        std::cerr << "expected 10 windows and 1200 detailed cycles\n";
+        ok = false;
+    }
+
+#ifdef PROJC_STATS
+    sampled.writeReport(std::cout, "text");
+    // Chaque valeur lue au CPU par le BUS (WIDTH 4) est une valeur consommée par le BUS
+    SampledRun::Estimate produced = sampled.estimate("Main processing unit", SampledRun::PRODUCED);
+    SampledRun::Estimate consumed = sampled.estimate("My bus 1", SampledRun::CONSUMED);
+    std::cout << " CPU produced/cycle=" << produced.perCycle << " BUS consumed/cycle=" << consumed.perCycle << "\n";
+    if (produced.windows != 10 || consumed.windows != 10 || produced.perCycle <= 0.0 || produced.perCycle > 4.0
+        || std::fabs(produced.perCycle - consumed.perCycle) > 1e-9 || std::isnan(produced.halfWidth)) {
+        std::cerr << "inconsistent CPU/BUS throughput estimates\n";
+        ok = false;
+    }
+    SampledRun::Estimate missing = sampled.estimate("no such label", SampledRun::PRODUCED);
+    if (missing.windows != 0) {
+        std::cerr << "estimate for an unknown label\n";
+        ok = false;
+    }
+#endif
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simulation.h"
+#include "platform.h"
+
+// ======================================================================================
+//                           TEST SCHEDULER (idle skipping)
+// Procédure :
+// Plateforme écrite dans un répertoire temporaire :
+//   CPU (FREQUENCY 3) -> BUS (WIDTH 2) -> MEMORY (ACCESS 3) -> DISPLAY (REFRESH 5)
+//                                      -> MEMORY (ACCESS 2, CLOCK 2) -> DISPLAY (REFRESH 7)
+//   CPU arrêté (FREQUENCY 0) -> BUS inactif -> DISPLAY (REFRESH 4)
+// Simulée cycle par cycle, puis avec le Scheduler (un cycle par step, puis d'un bloc) :
+// mêmes sorties DISPLAY au même cycle, même nombre de cycles, même état final
+// (occupation des buffers, compteurs produced/consumed)
+// ======================================================================================
+
+static std::string dir;
+
+static std::string write(const std::string& name, const std::string& content) {
+    std::string path = dir + "/" + name;
+    std::ofstream(path) << content;
+    return path;
+}
+
+// (cycle, source du DISPLAY, valeurs) de chaque rafraîchissement
+using Refresh = std::tuple<std::uint64_t, std::string, std::vector<value_t>>;
+
+static std::vector<Refresh> run(const std::string& root, bool idleSkip, std::uint64_t cycles, bool oneStep,
+                                Simulation& sim) {
+    std::vector<Refresh> out;
+    sim.load(root);
+    sim.getPlatform().setIdleSkipping(idleSkip);
+    sim.onOutput([&](const Display& d, const value_t* v, std::size_t n) {
+        out.emplace_back(oneStep ? 0 : sim.getCycle() + 1, d.getSourceLabel(), std::vector<value_t>(v, v + n));
+    });
+    if (oneStep) {
+        sim.step(cycles);
+    } else {
+        for (std::uint64_t i = 0; i < cycles; ++i) sim.step(1);
+    }
+    sim.onOutput(nullptr);
+    return out;
+}
+
+// Occupation et compteurs de chaque composant lisible
+static std::string state(Simulation& sim) {
+    std::string s;
+    sim.getPlatform().forEachComponent([&s](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<T, CPU>) s += c.getLabel() + " reg=" + std::to_string(c.getRegisterDepth());
+        else if constexpr (std::is_same_v<T, BUS>) s += c.getLabel() + " ready=" + std::to_string(c.getReadySize())
+                                                      + " pending=" + std::to_string(c.getPendingSize());
+        else if constexpr (std::is_same_v<T, Memory>) s += c.getLabel() + " count=" + std::to_string(c.getCount());
+        else return;
+#ifdef PROJC_STATS
+        s += " produced=" + std::to_string(c.getStats().produced) + " consumed=" + std::to_string(c.getStats().consumed);
+#endif
+        s += "\n";
+    });
+    return s;
+}
+
+int main() {
+    std::cout << "TESTSCHEDULER: start\n";
+    bool ok = true;
+
+    dir = "/tmp/testscheduler_" + std::to_string(getpid());
+    mkdir(dir.c_str(), 0755);
+    std::vector<std::string> files = {
+        write("cpu.txt", "TYPE: CPU\nLABEL: Busy CPU\nCORES: 2\nFREQUENCY: 3\nPROGRAM: data/program2.txt\n"),
+        write("bus.txt", "TYPE: BUS\nLABEL: Busy bus\nWIDTH: 2\nSOURCE: Busy CPU\n"),
+        write("mem.txt", "TYPE: MEMORY\nLABEL: Slow mem\nSIZE: 16\nACCESS: 3\nSOURCE: Busy bus\n"),
+        write("display.txt", "TYPE: DISPLAY\nREFRESH: 5\nSOURCE: Slow mem\n"),
+        write("mem2.txt", "TYPE: MEMORY\nLABEL: Half mem\nSIZE: 8\nACCESS: 2\nCLOCK: 2\nSOURCE: Busy bus\n"),
+        write("display2.txt", "TYPE: DISPLAY\nREFRESH: 7\nSOURCE: Half mem\n"),
+        write("idle_cpu.txt", "TYPE: CPU\nLABEL: Stopped CPU\nFREQUENCY: 0\nPROGRAM: data/program2.txt\n"),
+        write("idle_bus.txt", "TYPE: BUS\nLABEL: Idle bus\nWIDTH: 4\nSOURCE: Stopped CPU\n"),
+        write("idle_display.txt", "TYPE: DISPLAY\nREFRESH: 4\nSOURCE: Idle bus\n"),
+    };
+    std::string platform = "TYPE: PLATFORM\nLABEL: Skip platform\n";
+    for (const std::string& f : files) platform += "COMPONENT: " + f + "\n";
+    files.push_back(write("platform.txt", platform));
+    const std::string& root = files.back();
+
+    const std::uint64_t cycles = 500;
+    Simulation sequential, skipped, skippedBlock;
+    std::vector<Refresh> expected = run(root, false, cycles, false, sequential);
+    std::vector<Refresh> got = run(root, true, cycles, false, skipped);
+    std::size_t values = 0;
+    for (const Refresh& r : expected) values += std::get<2>(r).size();
+    std::cout << "  sequential: " << expected.size() << " refreshes, " << values << " values; idle-skip: "
+              << got.size() << " refreshes" << (got == expected ? " (identical)" : " MISMATCH") << "\n";
+    ok &= values > 0 && got == expected;
+    ok &= sequential.getCycle() == cycles && skipped.getCycle() == cycles;
+    ok &= state(sequential) == state(skipped);
+
+    // Même flot en un seul run() : le Scheduler saute les cycles sans activité
+    std::vector<Refresh> block = run(root, true, cycles, true, skippedBlock);
+    std::vector<Refresh> expectedNoCycle;
+    for (const Refresh& r : expected) expectedNoCycle.emplace_back(0, std::get<1>(r), std::get<2>(r));
+    ok &= block == expectedNoCycle && skippedBlock.getCycle() == cycles;
+    ok &= state(sequential) == state(skippedBlock);
+    std::cout << "  one run(" << cycles << "): " << (block == expectedNoCycle ? "identical" : "MISMATCH") << "\n";
+
+    for (const std::string& f : files) std::remove(f.c_str());
+    rmdir(dir.c_str());
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
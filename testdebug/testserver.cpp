@@ -0,0 +1,111 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "server.h"
+#include "simulation.h"
+
+// ======================================================================================
+//                           TEST SERVER
+// Procédure :
+// Démarre un SimServer (2 workers) sur une socket temporaire, data/platformA.txt préchargée
+// Deux clients connectés sans requête, puis deux clients simultanés : RUN de 50 cycles,
+// l'un avec WIDTH=2 sur "My bus 1"
+// Vérifie : les clients inactifs n'occupent pas les workers, sorties OUTPUT identiques à
+// une Simulation en mémoire avec les mêmes réglages, DONE final, erreurs pour une requête
+// invalide et un réglage inconnu, SHUTDOWN qui interrompt un RUN interminable
+// ======================================================================================
+
+static std::vector<std::string> expectedOutputs(const std::string& width) {
+    std::vector<std::string> lines;
+    Simulation sim;
+    sim.onOutput([&lines](const Display& d, const double* v, std::size_t n) {
+        std::ostringstream os;
+        for (std::size_t i = 0; i < n; ++i) os << (i ? " " : "") << v[i];
+        lines.push_back("OUTPUT\t" + d.getSourceLabel() + "\t" + os.str());
+    });
+    sim.load("data/platformA.txt");
+    if (!width.empty()) sim.setParam("My bus 1", "WIDTH", width);
+    sim.step(50);
+    return lines;
+}
+
+// Envoie une requête et renvoie les lignes OUTPUT ; last reçoit la dernière ligne
+static std::vector<std::string> request(const std::string& socketPath, const std::vector<std::string>& fields,
+                                        std::string& last) {
+    std::vector<std::string> outputs;
+    SimClient client;
+    if (!client.connect(socketPath) || !client.send(fields)) return outputs;
+    std::string line;
+    while (client.readLine(line)) {
+        last = line;
+        std::string kind = splitFields(line)[0];
+        if (kind == "OUTPUT") outputs.push_back(line);
+        if (kind == "DONE" || kind == "ERROR" || kind == "PONG") break;
+    }
+    return outputs;
+}
+
+int main() {
+    std::cout << "TESTSERVER: start\n";
+    bool ok = true;
+
+    std::vector<std::string> expected = expectedOutputs("");
+    std::vector<std::string> expectedNarrow = expectedOutputs("2");
+
+    std::string socketPath = "/tmp/projc-test-" + std::to_string(getpid()) + ".sock";
+    SimServer server(socketPath, 2);
+    if (!server.isOpen() || !server.addPlatform("A", "data/platformA.txt")) {
+        std::cerr << "FAILED to start the server\n";
+        return 2;
+    }
+    std::thread serving([&server] { server.serve(); });
+
+    // Autant de connexions inactives que de workers
+    SimClient idle1, idle2;
+    ok &= idle1.connect(socketPath) && idle2.connect(socketPath);
+
+    std::string lastA, lastB;
+    std::vector<std::string> gotA, gotB;
+    std::thread clientA([&] { gotA = request(socketPath, {"RUN", "A", "50"}, lastA); });
+    std::thread clientB([&] { gotB = request(socketPath, {"RUN", "A", "50", "My bus 1", "WIDTH", "2"}, lastB); });
+    clientA.join();
+    clientB.join();
+
+    std::cout << " outputs A=" << gotA.size() << " B=" << gotB.size() << " last A=" << lastA << "\n";
+    if (gotA.empty() || gotA != expected || gotB != expectedNarrow || expected == expectedNarrow) {
+        std::cerr << "server outputs differ from the in-process simulation\n";
+        ok = false;
+    }
+    if (lastA.rfind("DONE\t50\t", 0) != 0 || lastB.rfind("DONE\t50\t", 0) != 0) {
+        std::cerr << "expected DONE after each job\n";
+        ok = false;
+    }
+
+    std::string last;
+    request(socketPath, {"RUN", "A"}, last);
+    std::cout << " short RUN -> " << last << "\n";
+    if (last.rfind("ERROR", 0) != 0) ok = false;
+    request(socketPath, {"RUN", "A", "10", "no such label", "WIDTH", "2"}, last);
+    std::cout << " unknown label -> " << last << "\n";
+    if (last.rfind("ERROR", 0) != 0) ok = false;
+    request(socketPath, {"PING"}, last);
+    if (last != "PONG") ok = false;
+
+    // Un RUN sans fin prend un worker ; SHUTDOWN l'arrête à la fin d'une tranche
+    SimClient endless;
+    ok &= endless.connect(socketPath) && endless.send({"RUN", "A", "1000000000000"});
+    std::string line;
+    ok &= endless.readLine(line) && line.rfind("OUTPUT", 0) == 0; // le job tourne
+    request(socketPath, {"SHUTDOWN"}, last);
+    while (endless.readLine(line)) last = line;
+    std::cout << " endless RUN -> " << last << "\n";
+    if (last.rfind("ERROR", 0) != 0) ok = false;
+    serving.join();
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
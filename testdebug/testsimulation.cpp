@@ -0,0 +1,104 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "simulation.h"
+#include "platform.h"
+
+// ======================================================================================
+//                           TEST SIMULATION (libprojsim)
+// Procédure :
+// std::cout et std::cerr sont redirigés : rien ne doit y être écrit
+// Deux simulations de data/platformA.txt (mêmes labels) chargées dans le même processus
+// Chacune avance de 50 cycles ; sorties DISPLAY et messages reçus par les callbacks
+// Vérifie : sorties identiques, lecture d'un composant par label, compteurs,
+// échec de chargement signalé par onLog()
+// ======================================================================================
+
+struct Capture {
+    std::vector<std::vector<value_t>> lines;
+    std::vector<std::string> logs;
+};
+
+static void attach(Simulation& sim, Capture& cap) {
+    sim.onOutput([&cap](const Display&, const value_t* values, std::size_t n) {
+        cap.lines.emplace_back(values, values + n);
+    });
+    sim.onLog([&cap](LogLevel, const std::string& message) { cap.logs.push_back(message); });
+}
+
+int main() {
+    std::cout << "TESTSIMULATION: start\n";
+    bool ok = true;
+
+    std::ostringstream console;
+    std::streambuf* oldOut = std::cout.rdbuf(console.rdbuf());
+    std::streambuf* oldErr = std::cerr.rdbuf(console.rdbuf());
+
+    Capture capA, capB, capBad;
+    Simulation a, b, bad;
+    attach(a, capA);
+    attach(b, capB);
+    attach(bad, capBad);
+
+    bool loadedA = a.load("data/platformA.txt");
+    bool loadedB = b.load("data/platformA.txt");
+    bool loadedBad = bad.load("data/no_such_platform.txt");
+
+    a.step(50);
+    b.step(20);
+    b.step(30);
+
+    // Le MEMORY lit le BUS à chaque créneau : on lit le CPU, en amont
+    ComponentStats before{}, after{};
+    bool statsOk = a.getStats("Main processing unit", before);
+    DataValue v = a.read("Main processing unit");
+    a.getStats("Main processing unit", after);
+    DataValue unknown = a.read("no such label");
+
+    std::cout.rdbuf(oldOut);
+    std::cerr.rdbuf(oldErr);
+
+    std::cout << " loaded a=" << loadedA << " b=" << loadedB << " bad=" << loadedBad
+              << " cycles a=" << a.getCycle() << " b=" << b.getCycle() << "\n";
+    std::cout << " display lines a=" << capA.lines.size() << " b=" << capB.lines.size()
+              << " logs a=" << capA.logs.size() << " bad=" << capBad.logs.size() << "\n";
+    if (!console.str().empty()) {
+        std::cerr << "console output from the library:\n" << console.str();
+        ok = false;
+    }
+    if (!loadedA || !loadedB || loadedBad || capBad.logs.empty()) {
+        std::cerr << "unexpected load results\n";
+        ok = false;
+    }
+    if (capA.lines.empty() || capA.lines != capB.lines) {
+        std::cerr << "display outputs differ between the two simulations\n";
+        ok = false;
+    }
+    if (a.getCycle() != 50 || b.getCycle() != 50) {
+        std::cerr << "wrong cycle count\n";
+        ok = false;
+    }
+    if (unknown.valid) {
+        std::cerr << "read of an unknown label returned a value\n";
+        ok = false;
+    }
+    std::vector<std::string> labels = a.getLabels();
+    std::cout << " labels=" << labels.size() << " read CPU -> " << (v.valid ? std::to_string(v.value) : "none") << "\n";
+    if (labels.size() != 3) {
+        std::cerr << "expected 3 labeled components\n";
+        ok = false;
+    }
+#ifdef PROJC_STATS
+    if (!statsOk || (v.valid && after.produced != before.produced + 1)) {
+        std::cerr << "counters not updated by read()\n";
+        ok = false;
+    }
+#else
+    (void)statsOk;
+#endif
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
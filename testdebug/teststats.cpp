@@ -0,0 +1,102 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simulation.h"
+#include "platform.h"
+
+// ======================================================================================
+//                           TEST STATS (compteurs de performance)
+// Procédure :
+// Plateforme écrite dans un répertoire temporaire, 40 cycles :
+//   CPU (1 coeur, FREQUENCY 2, programme "DIV 6 0 / ADD 1 2")
+//     -> BUS (WIDTH 1) -> MEMORY (SIZE 2, ACCESS 4) -> DISPLAY (REFRESH 10)
+// Déroulé : le CPU calcule ses 2 instructions un cycle sur deux (l'autre cycle atteint
+// la fin du programme, sans résultat) ; le BUS en prend une par cycle ; la MEMORY vide
+// le BUS tous les 4 cycles (2 valeurs la première fois, 4 ensuite) et ne garde que les 2
+// dernières ; le DISPLAY la vide aux cycles 10, 20, 30, 40 (après la MEMORY)
+// Vérifie chaque compteur contre ce déroulé (compilé avec -DPROJC_STATS uniquement)
+// ======================================================================================
+
+#ifdef PROJC_STATS
+static std::string dir;
+
+static std::string write(const std::string& name, const std::string& content) {
+    std::string path = dir + "/" + name;
+    std::ofstream(path) << content;
+    return path;
+}
+
+static bool expect(const std::string& label, const ComponentStats& s, std::uint64_t produced, std::uint64_t consumed,
+                   std::uint64_t emptyReads, std::uint64_t dropped, std::uint64_t stall, std::uint64_t occupancy,
+                   std::uint64_t peak) {
+    bool ok = s.produced == produced && s.consumed == consumed && s.emptyReads == emptyReads && s.dropped == dropped
+              && s.stallCycles == stall && s.samples == 40 && s.occupancySum == occupancy && s.peakOccupancy == peak;
+    std::cout << "  " << label << ": produced=" << s.produced << " consumed=" << s.consumed << " empty=" << s.emptyReads
+              << " dropped=" << s.dropped << " stall=" << s.stallCycles << " occupancy=" << s.occupancySum << "/"
+              << s.samples << " peak=" << s.peakOccupancy << (ok ? "" : " MISMATCH") << "\n";
+    return ok;
+}
+#endif
+
+int main() {
+    std::cout << "TESTSTATS: start\n";
+    bool ok = true;
+
+#ifdef PROJC_STATS
+    dir = "/tmp/teststats_" + std::to_string(getpid());
+    mkdir(dir.c_str(), 0755);
+    std::vector<std::string> files = {
+        write("program.txt", "DIV 6 0\nADD 1 2\n"),
+    };
+    files.push_back(write("cpu.txt", "TYPE: CPU\nLABEL: Div CPU\nCORES: 1\nFREQUENCY: 2\nPROGRAM: " + files[0] + "\n"));
+    files.push_back(write("bus.txt", "TYPE: BUS\nLABEL: Narrow bus\nWIDTH: 1\nSOURCE: Div CPU\n"));
+    files.push_back(write("mem.txt", "TYPE: MEMORY\nLABEL: Small mem\nSIZE: 2\nACCESS: 4\nSOURCE: Narrow bus\n"));
+    files.push_back(write("display.txt", "TYPE: DISPLAY\nREFRESH: 10\nSOURCE: Small mem\n"));
+    std::string platform = "TYPE: PLATFORM\nLABEL: Stats platform\n";
+    for (std::size_t i = 1; i < files.size(); ++i) platform += "COMPONENT: " + files[i] + "\n";
+    files.push_back(write("platform.txt", platform));
+
+    Simulation sim;
+    ok &= sim.load(files.back());
+    std::size_t shown = 0;
+    sim.onOutput([&shown](const Display&, const value_t*, std::size_t n) { shown += n; });
+    sim.step(40);
+
+    ComponentStats cpu, bus, mem;
+    ok &= sim.getStats("Div CPU", cpu) && sim.getStats("Narrow bus", bus) && sim.getStats("Small mem", mem);
+    // 20 cycles à 2 résultats (dont une division par zéro), 20 cycles sans résultat ;
+    // registre relevé à 2 puis à 1 (le BUS en a pris un entre-temps)
+    ok &= expect("Div CPU", cpu, 40, 0, 0, 0, 20, 20 * 2 + 20 * 1, 2);
+    ok &= cpu.divByZero == 20;
+    // Une lecture par cycle ; la MEMORY prend 2 + 9 x 4 valeurs, chaque vidage finit par
+    // une lecture vide ; ready + pending : 1, 2, 3, puis 2, 3, 4, 5 tous les 4 cycles
+    ok &= expect("Narrow bus", bus, 38, 40, 10, 0, 0, 1 + 2 + 3 + 9 * (2 + 3 + 4 + 5) + 2, 5);
+    // 38 valeurs écrites, 8 affichées, 30 écrasées ; 2 valeurs pendant 7 + 9 + 7 + 9 cycles ;
+    // le readBatch de chaque rafraîchissement n'obtient pas le bloc demandé (lecture vide)
+    ok &= expect("Small mem", mem, 8, 38, 4, 30, 0, (7 + 9 + 7 + 9) * 2, 2);
+
+    sim.getPlatform().forEachComponent([&ok](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<T, Display>) {
+            ok &= c.getStats().consumed == 8 && c.getStats().stallCycles == 0;
+        }
+    });
+    ok &= shown == 8;
+
+    for (const std::string& f : files) std::remove(f.c_str());
+    rmdir(dir.c_str());
+#else
+    ComponentStats stats;
+    Simulation sim;
+    ok &= sim.load("data/platformA.txt") && !sim.getStats("DRAM 1", stats);
+    std::cout << "  compteurs désactivés (compilé sans PROJC_STATS)\n";
+#endif
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
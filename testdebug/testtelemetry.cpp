@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "simulation.h"
+#include "platform.h"
+#include "telemetry.h"
+
+// ======================================================================================
+//                           TEST TELEMETRY
+// Procédure :
+// data/platformA.txt, relevé tous les 3 cycles, réduction par groupes de 4 relevés,
+// blocs de 10 lignes demandés (ramenés à 8 : un nombre entier de groupes) ; 23 relevés :
+// deux blocs pleins et un bloc partiel dont le dernier groupe n'a que 3 lignes.
+// Le test relève lui-même l'occupation à chaque sample() puis relit le fichier (format de
+// telemetry.h, comme tsdump) : en-tête, noms des colonnes, et pour chaque groupe le
+// premier cycle, le min, le max et la moyenne de chaque colonne
+// ======================================================================================
+
+template <typename T>
+static bool readRaw(std::ifstream& f, T* data, std::size_t n) {
+    return static_cast<bool>(f.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(n * sizeof(T))));
+}
+
+// Occupation de chaque colonne, dans l'ordre de Telemetry
+static std::vector<std::uint32_t> row(Platform& platform) {
+    std::vector<std::uint32_t> values;
+    platform.forEachComponent([&values](auto& c) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<T, BUS>) {
+            values.push_back(static_cast<std::uint32_t>(c.getReadySize()));
+            values.push_back(static_cast<std::uint32_t>(c.getPendingSize()));
+        } else if constexpr (std::is_same_v<T, Memory>) {
+            values.push_back(static_cast<std::uint32_t>(c.getCount()));
+        } else if constexpr (std::is_same_v<T, CPU>) {
+            values.push_back(static_cast<std::uint32_t>(c.getRegisterDepth()));
+        }
+    });
+    return values;
+}
+
+int main() {
+    std::cout << "TESTTELEMETRY: start\n";
+    bool ok = true;
+
+    const std::string path = "/tmp/testtelemetry_" + std::to_string(getpid()) + ".bin";
+    const std::uint32_t every = 3, downsample = 4;
+    const std::size_t samples = 23, blockRows = 8;
+
+    Simulation sim;
+    ok &= sim.load("data/platformA.txt");
+    sim.onOutput([](const Display&, const value_t*, std::size_t) {});
+    std::vector<std::uint64_t> cycles;
+    std::vector<std::vector<std::uint32_t>> rows;
+    {
+        Telemetry telemetry(sim.getPlatform(), path, every, downsample, 10);
+        ok &= telemetry.isOpen() && telemetry.columnCount() == 4;
+        while (rows.size() < samples) {
+            sim.step(every);
+            telemetry.sample(sim.getCycle());
+            cycles.push_back(sim.getCycle());
+            rows.push_back(row(sim.getPlatform()));
+        }
+        telemetry.close();
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    char magic[8];
+    std::uint32_t header[3];
+    ok &= readRaw(file, magic, 8) && std::memcmp(magic, Telemetry::MAGIC, 8) == 0 && readRaw(file, header, 3);
+    ok &= header[0] == 4 && header[1] == every && header[2] == downsample;
+    std::vector<std::string> names(header[0]);
+    for (auto& name : names) {
+        std::uint32_t size = 0;
+        ok &= readRaw(file, &size, 1);
+        name.resize(size);
+        ok &= size > 0 && readRaw(file, &name[0], size);
+    }
+    ok &= names == std::vector<std::string>({"Main processing unit.register", "DRAM 1.count", "My bus 1.ready",
+                                             "My bus 1.pending"});
+
+    // Blocs : groupes de downsample relevés consécutifs, jamais à cheval sur deux blocs
+    std::size_t first = 0, groups = 0;
+    bool varies = false;
+    std::uint32_t n = 0;
+    while (ok && readRaw(file, &n, 1)) {
+        std::size_t inBlock = std::min(blockRows, samples - first);
+        ok &= n == (inBlock + downsample - 1) / downsample;
+        std::vector<std::uint64_t> groupCycles(n);
+        ok &= readRaw(file, groupCycles.data(), n);
+        for (std::size_t c = 0; c < names.size(); ++c) {
+            std::vector<std::uint32_t> mins(n), maxs(n);
+            std::vector<float> avgs(n);
+            ok &= readRaw(file, mins.data(), n) && readRaw(file, maxs.data(), n) && readRaw(file, avgs.data(), n);
+            for (std::size_t g = 0; ok && g < n; ++g) {
+                std::size_t begin = first + g * downsample;
+                std::size_t end = std::min(first + inBlock, begin + downsample);
+                std::uint32_t mn = rows[begin][c], mx = rows[begin][c];
+                double sum = 0.0;
+                for (std::size_t r = begin; r < end; ++r) {
+                    mn = std::min(mn, rows[r][c]);
+                    mx = std::max(mx, rows[r][c]);
+                    sum += rows[r][c];
+                }
+                ok &= groupCycles[g] == cycles[begin];
+                ok &= mins[g] == mn && maxs[g] == mx && avgs[g] == static_cast<float>(sum / static_cast<double>(end - begin));
+                varies |= mn != mx;
+            }
+        }
+        groups += n;
+        first += inBlock;
+    }
+    ok &= first == samples && groups == (8 / downsample) * 2 + 2 && varies;
+    std::cout << "  " << samples << " samples -> " << groups << " groups of " << downsample << " over "
+              << names.size() << " columns\n";
+
+    std::remove(path.c_str());
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
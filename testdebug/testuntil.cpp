@@ -0,0 +1,97 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "simulation.h"
+#include "platform.h"
+#include "until.h"
+
+// ======================================================================================
+//                           TEST UNTIL
+// Procédure :
+// data/platformA.txt : CPU -> BUS -> MEMORY -> DISPLAY, avancée cycle par cycle jusqu'à
+// ce que check() signale une condition ; vérifie qu'elle vient de devenir vraie :
+//   mem:DRAM 1>=20, value:My bus 1>=4, stat:Main processing unit.produced>=50,
+//   idle (après FREQUENCY 0 sur le CPU, une fois les buffers vidés)
+// Vérifie aussi le refus des syntaxes invalides et des labels inconnus
+// ======================================================================================
+
+// Cycle (depuis le début de run) où la première condition devient vraie, 0 si jamais
+static std::uint64_t run(Simulation& sim, StopConditions& until, std::uint64_t max, const std::string** hit) {
+    for (std::uint64_t i = 1; i <= max; ++i) {
+        sim.step(1);
+        if ((*hit = until.check())) return i;
+    }
+    return 0;
+}
+
+int main() {
+    std::cout << "TESTUNTIL: start\n";
+    bool ok = true;
+
+    std::vector<std::string> logs;
+    Log::Sink collect = [&logs](LogLevel, const std::string& message) { logs.push_back(message); };
+    Log::Scope scope(&collect);
+
+    // Syntaxes refusées
+    StopConditions bad;
+    for (const char* spec : {"never", "mem:DRAM 1", "mem:>=3", "value:My bus 1>abc", "stat:CPU>=3", "mem:DRAM 1=>3"}) {
+        ok &= !bad.add(spec);
+    }
+    ok &= bad.empty();
+
+    Simulation sim;
+    ok &= sim.load("data/platformA.txt");
+    Platform& platform = sim.getPlatform();
+    auto* mem = static_cast<Memory*>(platform.getRegistry().find("DRAM 1"));
+    auto* bus = static_cast<BUS*>(platform.getRegistry().find("My bus 1"));
+
+    // Label inconnu ou de mauvais type : compile() échoue
+    StopConditions unknown;
+    ok &= unknown.add("mem:My bus 1>=3") && unknown.add("value:Nowhere>0");
+    ok &= !unknown.compile(platform);
+
+    // Remplissage de la MEMORY
+    StopConditions fill;
+    ok &= fill.add("mem:DRAM 1>=20") && fill.compile(platform);
+    ok &= fill.check() == nullptr;
+    const std::string* hit = nullptr;
+    std::uint64_t at = run(sim, fill, 1000, &hit);
+    std::cout << "  mem:DRAM 1>=20 at cycle " << at << " (count " << mem->getCount() << ")\n";
+    ok &= at > 0 && hit && *hit == "mem:DRAM 1>=20" && mem->getCount() >= 20;
+
+    // Watchpoint : valeur lue par le BUS pendant le cycle
+    StopConditions watch;
+    ok &= watch.add("value:My bus 1>=4") && watch.compile(platform);
+    at = run(sim, watch, 1000, &hit);
+    bool seen = false;
+    for (std::size_t i = 0; i < bus->getPending().size(); ++i) {
+        seen |= Value::toDouble(bus->getPending()[i].value) >= 4.0;
+    }
+    std::cout << "  value:My bus 1>=4 at cycle " << at << "\n";
+    ok &= at > 0 && seen;
+
+#ifdef PROJC_STATS
+    // Seuil d'un compteur (plusieurs conditions : la première vraie est signalée)
+    StopConditions counter;
+    ok &= counter.add("mem:DRAM 1>1000") && counter.add("stat:Main processing unit.produced>=500");
+    ok &= counter.compile(platform);
+    at = run(sim, counter, 1000, &hit);
+    ComponentStats stats;
+    ok &= sim.getStats("Main processing unit", stats);
+    std::cout << "  stat:Main processing unit.produced>=500 at cycle " << at << " (produced " << stats.produced << ")\n";
+    ok &= at > 0 && hit && *hit == "stat:Main processing unit.produced>=500" && stats.produced >= 500;
+#endif
+
+    // Plateforme vidée : CPU arrêté, puis BUS, MEMORY et registres vidés
+    StopConditions idle;
+    ok &= idle.add("idle") && idle.compile(platform);
+    ok &= idle.check() == nullptr;
+    ok &= sim.setParam("Main processing unit", "FREQUENCY", "0");
+    at = run(sim, idle, 1000, &hit);
+    std::cout << "  idle at cycle " << at << "\n";
+    ok &= at > 0 && mem->getCount() == 0 && bus->getReadySize() == 0 && !sim.hasData("Main processing unit");
+
+    std::cout << (ok ? "TEST PASS\n" : "TEST FAIL\n");
+    return ok ? 0 : 1;
+}
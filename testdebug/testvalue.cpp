@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include "cpu.h"
+
+// ======================================================================================
+//                           TEST VALUE
+// Procédure :
+// Vérifie les opérations de ValueTraits pour chaque type de valeur (double, float,
+// int64, Fixed<16>), quel que soit le type choisi pour la build
+// Vérifie la lecture des opérandes d'un programme et Instruction::compute() pour value_t
+// Vérifie les formats d'affichage (GENERAL identique à operator<<, SHORTEST, FIXED, HEX)
+// ======================================================================================
+
+template <typename T>
+static bool check(const char* what, T got, double expected) {
+    double d = ValueTraits<T>::toDouble(got);
+    if (d != expected) {
+        std::cout << "  FAIL " << ValueTraits<T>::name() << " " << what << ": " << d << " != " << expected << "\n";
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+static bool checkType(double l, double r, double add, double sub, double mul, double div) {
+    using V = ValueTraits<T>;
+    T a = V::fromDouble(l);
+    T b = V::fromDouble(r);
+    bool ok = check("add", V::add(a, b), add);
+    ok &= check("sub", V::sub(a, b), sub);
+    ok &= check("mul", V::mul(a, b), mul);
+    ok &= check("div", V::div(a, b), div);
+    ok &= V::isZero(V::fromDouble(0.0)) && !V::isZero(a);
+    return ok;
+}
+
+static std::string formatted(double v, ValueFormat fmt, int precision) {
+    char text[64];
+    char* end = ValueTraits<double>::format(text, text + sizeof(text), v, fmt, precision);
+    return end ? std::string(text, end) : "(trop long)";
+}
+
+template <typename T>
+static bool checkRead(const std::string& text, double expected) {
+    std::istringstream in(text);
+    T v{};
+    return ValueTraits<T>::read(in, v) && check("read", v, expected);
+}
+
+int main() {
+    std::cout << "TESTVALUE: start (build : " << Value::name() << ", sizeof(DataValue) = "
+              << sizeof(DataValue) << ")\n";
+    bool ok = true;
+
+    ok &= checkType<double>(7.5, 2.5, 10.0, 5.0, 18.75, 3.0);
+    ok &= checkType<float>(7.5, 2.5, 10.0, 5.0, 18.75, 3.0);
+    ok &= checkType<std::int64_t>(7, 2, 9, 5, 14, 3);
+    ok &= checkType<Fixed<16>>(7.5, 2.5, 10.0, 5.0, 18.75, 3.0);
+    ok &= checkType<Fixed<16>>(-1.5, 0.25, -1.25, -1.75, -0.375, -6.0);
+
+    // Cas limites : débordement modulo 2^64, INT64_MIN / -1
+    ok &= ValueTraits<std::int64_t>::add(INT64_MAX, 1) == INT64_MIN;
+    ok &= ValueTraits<std::int64_t>::div(INT64_MIN, -1) == INT64_MIN;
+    ok &= ValueTraits<std::int64_t>::div(-7, 2) == -3;
+
+    ok &= checkRead<double>("2.25", 2.25);
+    ok &= checkRead<float>("2.25", 2.25);
+    ok &= checkRead<std::int64_t>("9007199254740993", 9007199254740992.0); // lu exact, affiché arrondi
+    ok &= checkRead<std::int64_t>("2.75", 2);
+    ok &= checkRead<Fixed<16>>("2.25", 2.25);
+    {
+        std::istringstream in("1x");
+        std::int64_t v;
+        ok &= !ValueTraits<std::int64_t>::read(in, v);
+    }
+
+    // Type de la build : opérandes, calcul et division par zéro
+    Instruction add(ADD, Value::fromDouble(3), Value::fromDouble(4));
+    Instruction div(DIV, Value::fromDouble(8), Value::fromDouble(2));
+    ok &= check("compute add", add.compute(), 7.0);
+    ok &= check("compute div", div.compute(), 4.0);
+    {
+        Log::Sink quiet = [](LogLevel, const std::string&) {};
+        Log::Scope scope(&quiet);
+        Instruction zero(DIV, Value::fromDouble(1), value_t{});
+        ok &= Value::isZero(zero.compute());
+    }
+
+    // Formats d'affichage : GENERAL par défaut identique à operator<<
+    struct Format { ValueFormat fmt; int precision; double v; const char* expected; };
+    const Format formats[] = {
+        {ValueFormat::GENERAL, -1, 1.0 / 3.0, "0.333333"},
+        {ValueFormat::GENERAL, 3, 1500.06, "1.5e+03"},
+        {ValueFormat::SHORTEST, -1, 0.1, "0.1"},
+        {ValueFormat::FIXED, 2, 2.0 / 3.0, "0.67"},
+        {ValueFormat::HEX, -1, 3.0, "1.8p+1"},
+    };
+    for (const Format& f : formats) {
+        std::string s = formatted(f.v, f.fmt, f.precision);
+        if (s != f.expected) std::cout << "  FAIL format \"" << s << "\" != \"" << f.expected << "\"\n";
+        ok &= s == f.expected;
+    }
+    for (double v : {1.0 / 3.0, 1500.06, 4.02, -0.0, 1e-7, 12345678.0}) {
+        std::ostringstream os;
+        os << v;
+        ok &= formatted(v, ValueFormat::GENERAL, -1) == os.str();
+    }
+    {
+        std::string line;
+        appendValue(line, Value::fromDouble(2), ValueFormat::GENERAL, -1);
+        ok &= line == "2 ";
+        if constexpr (std::is_same_v<value_t, double>) {
+            appendValue(line, 1e100, ValueFormat::FIXED, 2); // plus long que le buffer sur la pile
+            ok &= line.size() == 2 + 101 + 3 + 1 && line.back() == ' ';
+        }
+    }
+
+    std::cout << (ok ? "TEST PASS" : "TEST FAIL") << "\n";
+    return ok ? 0 : 1;
+}
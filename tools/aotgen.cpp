@@ -0,0 +1,202 @@
+#include "lib.h"
+#include "platform.h"
+#include <map>
+#include <unordered_map>
+
+// ======================================================================================
+//                                 AOTGEN
+// Génère une unité de traduction C++ spécialisée pour une plateforme donnée
+// Usage : aotgen <platform_config_file> <output.cpp>
+// Le fichier produit (cf aot.h) contient :
+// - chaque composant comme objet membre concret, de type exact, paramètres en template
+// - les programmes en tableaux constexpr (dédupliqués)
+// - un simulate() qui appelle les composants dans l'ordre de Platform::simulate()
+// Compilation : g++ -Iinclude -std=c++17 -O2 output.cpp -o sim_aot (ou make aot)
+// Le binaire prend le nombre de cycles en argument (ou sur stdin) et n'affiche que
+// les lignes DISPLAY, identiques à celles de sim.
+// ======================================================================================
+
+static std::string hexDouble(double v) {
+    std::ostringstream os;
+    os << std::hexfloat << v;
+    return os.str();
+}
+
+static std::string cString(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (c == '\n') { out += "\\n"; continue; }
+        out += c;
+    }
+    return out + "\"";
+}
+
+static std::string oneLine(const std::string& s) {
+    std::string out = s;
+    for (char& c : out) if (c == '\n' || c == '\r') c = ' ';
+    return out;
+}
+
+static const char* opcodeName(OPCODE op) {
+    switch (op) {
+        case ADD: return "ADD";
+        case SUB: return "SUB";
+        case MUL: return "MUL";
+        case DIV: return "DIV";
+        case NOP: break;
+    }
+    return "NOP";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <platform_config_file> <output.cpp>" << std::endl;
+        return 1;
+    }
+
+    Platform platform("NotLoadedPlatform");
+    if (!platform.loadFromFile(argv[1])) {
+        std::cerr << "Error: Failed to load platform configuration." << std::endl;
+        return 1;
+    }
+
+    // Composants feuilles dans l'ordre de simulate(), indexés par adresse pour les sources
+    struct Node {
+        Component* component;
+        std::string kind;
+        std::string path;
+        std::string label;
+    };
+    std::vector<Node> nodes;
+    std::unordered_map<const ReadableComponent*, std::size_t> indexOf;
+    std::size_t unsupported = 0;
+    platform.forEachComponentPath([&](auto& c, const std::string& path) {
+        using T = std::decay_t<decltype(c)>;
+        if (!c.getClock().isBase()) {
+            // aot.h simule tout à l'horloge de base
+            std::cerr << "Error: CLOCK of a component in " << path << " is not supported by aotgen" << std::endl;
+            ++unsupported;
+        }
+        if constexpr (std::is_same_v<T, CoroutineComponent>) {
+            // Pas d'équivalent dans aot.h : le comportement est une coroutine, pas un état plat
+            std::cerr << "Error: " << c.typeName() << " \"" << c.getLabel() << "\" (" << path
+                      << ") is not supported by aotgen" << std::endl;
+            ++unsupported;
+        } else if constexpr (!std::is_same_v<T, Platform>) {
+            if constexpr (std::is_base_of_v<ReadableComponent, T>) indexOf[&c] = nodes.size();
+            if constexpr (std::is_same_v<T, CPU>) nodes.push_back({&c, "CPU", path, c.getLabel()});
+            else if constexpr (std::is_same_v<T, BUS>) nodes.push_back({&c, "BUS", path, c.getLabel()});
+            else if constexpr (std::is_same_v<T, Memory>) nodes.push_back({&c, "MEMORY", path, c.getLabel()});
+            else if constexpr (std::is_same_v<T, Display>) nodes.push_back({&c, "DISPLAY", path, "<- " + c.getSourceLabel()});
+        }
+    });
+
+    if (unsupported) return 1;
+
+    std::ostringstream programs, labels, types, members, binds, calls;
+    std::map<std::string, std::string> programNames; // contenu -> nom du tableau
+    std::size_t displays = 0;
+
+    // Type et expression d'adresse de la source d'un composant (NoSource hors plateforme)
+    auto sourceOf = [&](ReadableComponent* src, std::string& type, std::string& address) {
+        // Une plateforme source est remplacée par le composant de son OUTPUT
+        auto it = src ? indexOf.find(src->producer()) : indexOf.end();
+        if (it == indexOf.end()) {
+            type = "aot::NoSource";
+            address = "&aot::noSource";
+        } else {
+            type = "C" + std::to_string(it->second);
+            address = "&c" + std::to_string(it->second);
+        }
+    };
+
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        const Node& n = nodes[i];
+        const std::string name = "C" + std::to_string(i);
+        const std::string member = "c" + std::to_string(i);
+        std::string srcType, srcAddress;
+        bool emitted = true;
+
+        if (n.kind == "CPU") {
+            const CPU& cpu = *static_cast<CPU*>(n.component);
+            const Program& code = cpu.getProgram();
+            std::ostringstream body;
+            for (const Instruction& instr : code) {
+                body << "    {" << opcodeName(instr.opcode) << ", " << hexDouble(Value::toDouble(instr.left()))
+                     << ", " << hexDouble(Value::toDouble(instr.right())) << "},\n";
+            }
+            std::string program = "nullptr";
+            if (!code.empty()) {
+                auto it = programNames.find(body.str());
+                if (it == programNames.end()) {
+                    std::string arrayName = "program" + std::to_string(programNames.size());
+                    programs << "constexpr aot::Op " << arrayName << "[] = {\n" << body.str() << "};\n";
+                    it = programNames.emplace(body.str(), arrayName).first;
+                }
+                program = it->second;
+            }
+            types << "struct " << name << " : aot::Cpu<" << cpu.getFrequency() << ", " << cpu.getNCores()
+                  << ", " << program << ", " << code.size() << "> {};";
+        } else if (n.kind == "BUS") {
+            BUS& bus = *static_cast<BUS*>(n.component);
+            if (bus.getSource()) sourceOf(bus.getSource(), srcType, srcAddress);
+            else srcType = "aot::NoSource";
+            types << "struct " << name << " : aot::Bus<" << bus.getWidth() << ", " << srcType << "> {};";
+        } else if (n.kind == "MEMORY") {
+            Memory& mem = *static_cast<Memory*>(n.component);
+            if (mem.getSource()) sourceOf(mem.getSource(), srcType, srcAddress);
+            else srcType = "aot::NoSource";
+            types << "struct " << name << " : aot::Memory<" << mem.getSize() << ", " << mem.getAccessTime()
+                  << ", " << srcType << "> {};";
+        } else {
+            Display& display = *static_cast<Display*>(n.component);
+            if (!display.getSource()) {
+                // Un DISPLAY sans source ne fait rien : pas de code
+                types << "// " << name << " : DISPLAY sans source, omis\n";
+                emitted = false;
+            } else {
+                sourceOf(display.getSource(), srcType, srcAddress);
+                std::string labelName = "label" + std::to_string(displays++);
+                labels << "constexpr char " << labelName << "[] = " << cString(display.getSourceLabel()) << ";\n";
+                types << "struct " << name << " : aot::Display<" << display.getRefreshRate() << ", " << srcType
+                      << ", " << labelName << ", ValueFormat(" << static_cast<int>(display.getFormat()) << "), "
+                      << display.getPrecision() << "> {};";
+            }
+        }
+
+        if (!emitted) continue;
+        types << " // " << n.kind << " \"" << oneLine(n.label) << "\" (" << oneLine(n.path) << ")\n";
+        members << "    " << name << " " << member << ";\n";
+        if (!srcAddress.empty()) binds << "        " << member << ".source = " << srcAddress << ";\n";
+        calls << "        " << member << ".simulate();\n";
+    }
+
+    std::ofstream out(argv[2], std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open " << argv[2] << std::endl;
+        return 1;
+    }
+
+    out << "// Généré par aotgen depuis " << oneLine(argv[1]) << " : ne pas modifier à la main\n"
+        << "#include \"aot.h\"\n\n"
+        << "namespace {\n\n"
+        << programs.str() << (programNames.empty() ? "" : "\n")
+        << labels.str() << (displays ? "\n" : "");
+    for (std::size_t i = 0; i < nodes.size(); ++i) out << "struct C" << i << ";\n";
+    out << "\n" << types.str() << "\n"
+        << "struct GeneratedPlatform {\n"
+        << members.str() << "\n"
+        << "    GeneratedPlatform() {\n" << binds.str() << "    }\n\n"
+        << "    void simulate() {\n" << calls.str() << "    }\n"
+        << "};\n\n"
+        << "GeneratedPlatform platform; // statique : les buffers des MEMORY ne sont pas sur la pile\n\n"
+        << "} // namespace\n\n"
+        << "int main(int argc, char* argv[]) {\n"
+        << "    return aot::run(platform, argc, argv);\n"
+        << "}\n";
+
+    std::cout << "Generated " << nodes.size() << " components (" << programNames.size()
+              << " programs) in " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "lib.h"
+#include "platform.h"
+#include <chrono>
+#include <sys/resource.h>
+
+// ======================================================================================
+//                                 BENCH
+// Exécute une plateforme sans sortie console et mesure sa performance
+// Usage : bench <platform_config_file> [--cycles N]
+// Résultat sur une ligne JSON :
+//   components, load_ms, cycles, cycles_per_sec, values (lectures BUS),
+//   values_per_sec, arena_kb (composants + état chaud), peak_rss_kb
+// ======================================================================================
+
+// streambuf qui jette tout : coupe les sorties des Display et du chargement
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <platform_config_file> [--cycles N]" << std::endl;
+        return 1;
+    }
+
+    std::string configFile = argv[1];
+    std::uint64_t cycles = 1000;
+    for (int a = 2; a + 1 < argc; a += 2) {
+        std::string opt = argv[a];
+        if (opt == "--cycles") cycles = std::stoull(argv[a + 1]);
+    }
+
+    NullBuffer null;
+    std::streambuf* saved = std::cout.rdbuf(&null);
+
+    using clock = std::chrono::steady_clock;
+    Platform platform("NotLoadedPlatform");
+
+    auto t0 = clock::now();
+    bool loaded = platform.loadFromFile(configFile);
+    auto t1 = clock::now();
+
+    if (!loaded) {
+        std::cout.rdbuf(saved);
+        std::cerr << "Error: Failed to load platform configuration." << std::endl;
+        return 1;
+    }
+
+    for (std::uint64_t i = 0; i < cycles; ++i) {
+        platform.simulate();
+    }
+    auto t2 = clock::now();
+
+    std::cout.rdbuf(saved);
+
+    std::uint64_t values = 0;
+    platform.forEachComponent([&values](auto& c) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(c)>, BUS>) {
+            values += static_cast<std::uint64_t>(c.getReadCount());
+        }
+    });
+
+    double loadMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    double runSec = std::chrono::duration<double>(t2 - t1).count();
+    if (runSec <= 0.0) runSec = 1e-9;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    std::cout << "{\"platform\": \"" << report::jsonEscape(configFile) << "\""
+              << ", \"components\": " << platform.componentCount()
+              << ", \"load_ms\": " << loadMs
+              << ", \"cycles\": " << cycles
+              << ", \"cycles_per_sec\": " << static_cast<double>(cycles) / runSec
+              << ", \"values\": " << values
+              << ", \"values_per_sec\": " << static_cast<double>(values) / runSec
+              << ", \"arena_kb\": " << platform.arenaBytes() / 1024
+              << ", \"peak_rss_kb\": " << usage.ru_maxrss
+              << "}" << std::endl;
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+// ======================================================================================
+//                                 GENPLATFORM
+// Générateur de plateformes synthétiques pour les benchmarks de montée en charge
+// Usage : genplatform <out_dir> [options]
+//   --cpus N            nombre de CPU (un pipeline par CPU)                  (1)
+//   --fanout F          nombre de BUS lisant une même source                 (2)
+//   --stages S          nombre d'étages BUS -> MEMORY par branche            (2)
+//   --displays D        nombre de DISPLAY par pipeline (fin des D premières
+//                       branches)                                           (1)
+//   --depth D           profondeur de la hiérarchie de plateformes, 1 = plate (1)
+//   --program-len L     nombre d'instructions par programme                  (8)
+//   --frequency F       FREQUENCY des CPU                                    (4)
+//   --width W           WIDTH des BUS                                        (4)
+//   --mem-size S        SIZE des MEMORY                                      (64)
+//   --access A          ACCESS des MEMORY                                    (2)
+//   --refresh R         REFRESH des DISPLAY                                  (8)
+// Un pipeline = CPU -> F branches de S étages (BUS -> MEMORY) -> DISPLAY
+// soit 1 + 2*F*S + D composants par CPU. Le fichier racine est <out_dir>/platform.txt
+// ======================================================================================
+
+struct GenOptions {
+    int cpus{1};
+    int fanout{2};
+    int stages{2};
+    int displays{1};
+    int depth{1};
+    int programLen{8};
+    int frequency{4};
+    int width{4};
+    int memSize{64};
+    int access{2};
+    int refresh{8};
+};
+
+static const int PROGRAM_VARIANTS = 4; // programmes distincts, partagés entre les CPU
+
+static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path);
+    file << content;
+}
+
+// Écrit les fichiers d'un pipeline et renvoie la liste de ses composants (chemins)
+static std::vector<std::string> generatePipeline(const std::string& dir, int id, const GenOptions& opt) {
+    std::vector<std::string> files;
+    std::string cpuLabel = "CPU " + std::to_string(id);
+    std::string cpuFile = dir + "/cpu" + std::to_string(id) + ".txt";
+    writeFile(cpuFile, "TYPE: CPU\nLABEL: " + cpuLabel + "\nCORES: 1\nFREQUENCY: " + std::to_string(opt.frequency)
+                       + "\nPROGRAM: " + dir + "/program" + std::to_string(id % PROGRAM_VARIANTS) + ".txt\n");
+    files.push_back(cpuFile);
+
+    for (int f = 0; f < opt.fanout; ++f) {
+        std::string source = cpuLabel;
+        for (int s = 0; s < opt.stages; ++s) {
+            std::string suffix = std::to_string(id) + "_" + std::to_string(f) + "_" + std::to_string(s);
+            std::string busLabel = "BUS " + suffix;
+            std::string memLabel = "MEM " + suffix;
+            std::string busFile = dir + "/bus" + suffix + ".txt";
+            std::string memFile = dir + "/mem" + suffix + ".txt";
+            writeFile(busFile, "TYPE: BUS\nLABEL: " + busLabel + "\nWIDTH: " + std::to_string(opt.width)
+                               + "\nSOURCE: " + source + "\n");
+            writeFile(memFile, "TYPE: MEMORY\nLABEL: " + memLabel + "\nSIZE: " + std::to_string(opt.memSize)
+                               + "\nACCESS: " + std::to_string(opt.access) + "\nSOURCE: " + busLabel + "\n");
+            files.push_back(busFile);
+            files.push_back(memFile);
+            source = memLabel;
+        }
+        if (f < opt.displays) {
+            std::string displayFile = dir + "/display" + std::to_string(id) + "_" + std::to_string(f) + ".txt";
+            writeFile(displayFile, "TYPE: DISPLAY\nREFRESH: " + std::to_string(opt.refresh) + "\nSOURCE: " + source + "\n");
+            files.push_back(displayFile);
+        }
+    }
+    return files;
+}
+
+// Écrit une plateforme regroupant des composants, renvoie son chemin
+static std::string writePlatform(const std::string& path, const std::string& label, const std::vector<std::string>& components) {
+    std::string content = "TYPE: PLATFORM\nLABEL: " + label + "\n";
+    for (const auto& c : components) content += "COMPONENT: " + c + "\n";
+    writeFile(path, content);
+    return path;
+}
+
+static void usage(const char* program) {
+    std::cerr << "Usage: " << program << " <out_dir> [--cpus N] [--fanout F] [--stages S] [--displays D]"
+              << " [--depth D] [--program-len L] [--frequency F] [--width W] [--mem-size S]"
+              << " [--access A] [--refresh R]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::string dir = argv[1];
+    GenOptions opt;
+    for (int a = 2; a < argc; a += 2) {
+        std::string key = argv[a];
+        if (a + 1 >= argc) {
+            std::cerr << "Missing value for " << key << std::endl;
+            usage(argv[0]);
+            return 1;
+        }
+        std::string text = argv[a + 1];
+        int value = 0;
+        try {
+            std::size_t used = 0;
+            value = std::stoi(text, &used);
+            if (used != text.size()) throw std::invalid_argument(text);
+        } catch (...) {
+            std::cerr << "Invalid value '" << text << "' for " << key << std::endl;
+            usage(argv[0]);
+            return 1;
+        }
+        if (key == "--cpus") opt.cpus = value;
+        else if (key == "--fanout") opt.fanout = value;
+        else if (key == "--stages") opt.stages = value;
+        else if (key == "--displays") opt.displays = value;
+        else if (key == "--depth") opt.depth = value;
+        else if (key == "--program-len") opt.programLen = value;
+        else if (key == "--frequency") opt.frequency = value;
+        else if (key == "--width") opt.width = value;
+        else if (key == "--mem-size") opt.memSize = value;
+        else if (key == "--access") opt.access = value;
+        else if (key == "--refresh") opt.refresh = value;
+        else {
+            std::cerr << "Unknown option " << key << std::endl;
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (opt.depth < 1) opt.depth = 1;
+
+    mkdir(dir.c_str(), 0755);
+
+    const char* ops[] = {"ADD", "SUB", "MUL", "DIV"};
+    for (int v = 0; v < PROGRAM_VARIANTS; ++v) {
+        std::string program;
+        for (int i = 0; i < opt.programLen; ++i) {
+            program += std::string(ops[(i + v) % 4]) + " " + std::to_string(i + 1) + " " + std::to_string(v + 1) + "\n";
+        }
+        writeFile(dir + "/program" + std::to_string(v) + ".txt", program);
+    }
+
+    // Feuilles : un groupe de composants par pipeline
+    std::vector<std::vector<std::string>> groups;
+    std::size_t total = 0;
+    for (int id = 0; id < opt.cpus; ++id) {
+        groups.push_back(generatePipeline(dir, id, opt));
+        total += groups.back().size();
+    }
+
+    // Hiérarchie : (depth - 1) niveaux de sous-plateformes au-dessus des pipelines
+    int branching = opt.depth > 1
+        ? std::max(2, static_cast<int>(std::ceil(std::pow(static_cast<double>(opt.cpus), 1.0 / (opt.depth - 1)))))
+        : 1;
+    for (int level = 1; level < opt.depth; ++level) {
+        std::vector<std::vector<std::string>> parents;
+        for (std::size_t g = 0; g < groups.size(); g += branching) {
+            std::vector<std::string> members;
+            for (std::size_t k = g; k < std::min(groups.size(), g + branching); ++k) {
+                std::string name = "L" + std::to_string(level) + "_" + std::to_string(k);
+                members.push_back(writePlatform(dir + "/platform" + name + ".txt", "Platform " + name, groups[k]));
+                ++total;
+            }
+            parents.push_back(members);
+        }
+        groups.swap(parents);
+    }
+
+    std::vector<std::string> top;
+    for (const auto& g : groups) top.insert(top.end(), g.begin(), g.end());
+    writePlatform(dir + "/platform.txt", "Generated platform", top);
+
+    std::cout << "Generated " << total << " components in " << dir << "/platform.txt" << std::endl;
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "lib.h"
+#include "platform.h"
+
+// ======================================================================================
+//                                 MKIMAGE
+// Compile une arborescence de fichiers de config en une image binaire de plateforme
+// Usage : mkimage <platform_config_file> <output_image>
+// L'image produite se charge directement avec sim (détection par le magic du fichier)
+// ======================================================================================
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <platform_config_file> <output_image>" << std::endl;
+        return 1;
+    }
+
+    Platform platform("NotLoadedPlatform");
+    if (!platform.loadFromFile(argv[1])) {
+        std::cerr << "Error: Failed to load platform configuration." << std::endl;
+        return 1;
+    }
+
+    if (!platform.saveImage(argv[2])) {
+        std::cerr << "Error: Failed to write image " << argv[2] << std::endl;
+        return 1;
+    }
+
+    std::cout << "Image written to " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "server.h"
+#include <iostream>
+
+// ======================================================================================
+//                                 SIMCLIENT
+// Envoie une requête à un simserver (cf server.h) et affiche les réponses
+// Usage : simclient <socket> run <platform> <cycles> [--set LABEL:KEY=VALUE]...
+//         simclient <socket> list | ping | shutdown
+// Code de retour 0 si la requête se termine par DONE (ou PONG), 1 sinon
+// ======================================================================================
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <socket> run <platform> <cycles> [--set LABEL:KEY=VALUE]..." << std::endl;
+        std::cerr << "       " << argv[0] << " <socket> list | ping | shutdown" << std::endl;
+        return 1;
+    }
+    std::string command = argv[2];
+    std::vector<std::string> fields;
+    if (command == "run" && argc >= 5) {
+        fields = {"RUN", argv[3], argv[4]};
+        for (int a = 5; a < argc; ++a) {
+            std::string opt = argv[a];
+            std::string spec = (opt == "--set" && a + 1 < argc) ? argv[++a] : "";
+            std::size_t eq = spec.find('=');
+            std::size_t colon = eq == std::string::npos ? std::string::npos : spec.rfind(':', eq);
+            if (colon == std::string::npos || colon == 0) {
+                std::cerr << "Error: expected --set LABEL:KEY=VALUE, got " << opt << std::endl;
+                return 1;
+            }
+            fields.push_back(spec.substr(0, colon));
+            fields.push_back(spec.substr(colon + 1, eq - colon - 1));
+            fields.push_back(spec.substr(eq + 1));
+        }
+    } else if (command == "list" || command == "ping" || command == "shutdown") {
+        for (char& c : command) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        fields = {command};
+    } else {
+        std::cerr << "Error: unknown command " << command << std::endl;
+        return 1;
+    }
+
+    SimClient client;
+    if (!client.connect(argv[1])) {
+        std::cerr << "Error: Could not connect to " << argv[1] << std::endl;
+        return 1;
+    }
+    if (!client.send(fields)) return 1;
+
+    std::string line;
+    while (client.readLine(line)) {
+        std::cout << line << std::endl;
+        std::string kind = splitFields(line)[0];
+        if (kind == "DONE" || kind == "PONG") return 0;
+        if (kind == "ERROR") return 1;
+    }
+    std::cerr << "Error: connection closed" << std::endl;
+    return 1;
+}
@@ -0,0 +1,69 @@
+#include "server.h"
+#include "log.h"
+#include <csignal>
+#include <iostream>
+
+// ======================================================================================
+//                                 SIMSERVER
+// Serveur de simulation persistant (cf server.h), jusqu'à SIGINT/SIGTERM ou SHUTDOWN
+// Usage : simserver <socket> [--workers N] [--platform ID=FICHIER]...
+// Les plateformes --platform sont chargées au démarrage ; toute autre config est
+// chargée et mise en cache à sa première demande.
+// ======================================================================================
+
+static SimServer* running = nullptr;
+
+static void onSignal(int) {
+    if (running) running->stop();
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <socket> [--workers N] [--platform ID=FILE]..." << std::endl;
+        return 1;
+    }
+    std::string socketPath = argv[1];
+    unsigned workers = 0;
+    std::vector<std::pair<std::string, std::string>> preload;
+    for (int a = 2; a < argc; ++a) {
+        std::string opt = argv[a];
+        if (opt == "--workers" && a + 1 < argc) {
+            workers = static_cast<unsigned>(std::stoul(argv[++a]));
+        } else if (opt == "--platform" && a + 1 < argc) {
+            std::string spec = argv[++a];
+            std::size_t eq = spec.find('=');
+            if (eq == std::string::npos || eq == 0) {
+                std::cerr << "Error: --platform expects ID=FILE" << std::endl;
+                return 1;
+            }
+            preload.emplace_back(spec.substr(0, eq), spec.substr(eq + 1));
+        } else {
+            std::cerr << "Error: unknown option " << opt << std::endl;
+            return 1;
+        }
+    }
+
+    SimServer server(socketPath, workers);
+    if (!server.isOpen()) return 1;
+
+    // Messages de chargement des plateformes préchargées tus, seules les erreurs restent
+    Log::Sink quiet = [](LogLevel level, const std::string& message) {
+        if (level != LogLevel::INFO) std::cerr << message << std::endl;
+    };
+    {
+        Log::Scope scope(&quiet);
+        for (const auto& [id, file] : preload) {
+            if (!server.addPlatform(id, file)) return 1;
+            std::cout << "Platform " << id << " loaded from " << file << std::endl;
+        }
+    }
+
+    running = &server;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::cout << "Listening on " << socketPath << std::endl;
+    server.serve();
+    running = nullptr;
+    std::cout << "Server stopped" << std::endl;
+    return 0;
+}
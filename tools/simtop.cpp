@@ -0,0 +1,110 @@
+#include "livestats.h"
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ======================================================================================
+//                                 SIMTOP
+// Affiche en continu les statistiques publiées par sim --live <nom> (cf livestats.h)
+// Usage : simtop <nom_du_segment> [--interval ms] [--once]
+// Lecture sans verrou : copie du segment validée par le seqlock, recommencée sinon
+// ======================================================================================
+
+struct Snapshot {
+    std::uint64_t cycle{0}, total{0};
+    double rate{0.0};
+    struct Row { std::string type, label; std::uint64_t produced, consumed, occupancy; };
+    std::vector<Row> rows;
+};
+
+static Snapshot readSnapshot(const live::Segment* seg) {
+    Snapshot snap;
+    for (;;) {
+        std::uint64_t s1 = seg->seq.load(std::memory_order_acquire);
+        if (s1 & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        snap.cycle = seg->cycle.load(std::memory_order_relaxed);
+        snap.total = seg->totalCycles.load(std::memory_order_relaxed);
+        std::uint64_t bits = seg->cyclesPerSecBits.load(std::memory_order_relaxed);
+        std::memcpy(&snap.rate, &bits, sizeof(bits));
+        snap.rows.resize(seg->n_entries);
+        for (std::uint32_t i = 0; i < seg->n_entries; ++i) {
+            const live::Entry& e = seg->entries[i];
+            snap.rows[i].type.assign(e.type, strnlen(e.type, sizeof(e.type)));
+            snap.rows[i].label.assign(e.label, strnlen(e.label, sizeof(e.label)));
+            snap.rows[i].produced = e.produced.load(std::memory_order_relaxed);
+            snap.rows[i].consumed = e.consumed.load(std::memory_order_relaxed);
+            snap.rows[i].occupancy = e.occupancy.load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seg->seq.load(std::memory_order_relaxed) == s1) return snap;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <shm_name> [--interval ms] [--once]" << std::endl;
+        return 1;
+    }
+    std::string name = argv[1];
+    int intervalMs = 1000;
+    bool once = false;
+    for (int a = 2; a < argc; ++a) {
+        std::string opt = argv[a];
+        if (opt == "--once") once = true;
+        else if (opt == "--interval" && a + 1 < argc) intervalMs = std::stoi(argv[++a]);
+    }
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        std::cerr << "Error: no live segment named " << name << std::endl;
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(live::Segment)) {
+        std::cerr << "Error: " << name << " is not a live stats segment" << std::endl;
+        close(fd);
+        return 1;
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return 1;
+    const live::Segment* seg = static_cast<const live::Segment*>(map);
+
+    if (std::memcmp(seg->magic, live::MAGIC, sizeof(live::MAGIC)) != 0 || seg->version != live::VERSION
+        || live::Segment::bytesFor(seg->n_entries) > size) {
+        std::cerr << "Error: " << name << " is not a live stats segment" << std::endl;
+        return 1;
+    }
+
+    for (;;) {
+        Snapshot snap = readSnapshot(seg);
+        if (!once) std::printf("\033[2J\033[H");
+        std::printf("pid %llu  cycle %llu", static_cast<unsigned long long>(seg->pid),
+                    static_cast<unsigned long long>(snap.cycle));
+        if (snap.total) std::printf(" / %llu (%.1f%%)", static_cast<unsigned long long>(snap.total),
+                                    100.0 * snap.cycle / snap.total);
+        std::printf("  %.0f cycles/s\n", snap.rate);
+        std::printf("%-8s %-40s %14s %14s %10s\n", "type", "label", "produced", "consumed", "occupancy");
+        for (const auto& r : snap.rows) {
+            std::printf("%-8s %-40s %14llu %14llu %10llu\n", r.type.c_str(), r.label.c_str(),
+                        static_cast<unsigned long long>(r.produced), static_cast<unsigned long long>(r.consumed),
+                        static_cast<unsigned long long>(r.occupancy));
+        }
+        std::fflush(stdout);
+        if (once) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+
+    munmap(map, size);
+    return 0;
+}
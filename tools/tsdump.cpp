@@ -0,0 +1,72 @@
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ======================================================================================
+//                                 TSDUMP
+// Relit un fichier de télémétrie (cf telemetry.h) et l'affiche en CSV
+// Usage : tsdump <telemetry_file>
+// Colonnes : cycle puis, pour chaque série, <nom>.min, <nom>.max, <nom>.avg
+// ======================================================================================
+
+template <typename T>
+static bool readRaw(std::ifstream& f, T* data, std::size_t n) {
+    return static_cast<bool>(f.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(n * sizeof(T))));
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <telemetry_file>" << std::endl;
+        return 1;
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    char magic[8];
+    std::uint32_t n_cols, every, downsample;
+    if (!file.is_open() || !readRaw(file, magic, 8) || std::memcmp(magic, "PROJCTS1", 8) != 0
+        || !readRaw(file, &n_cols, 1) || !readRaw(file, &every, 1) || !readRaw(file, &downsample, 1)) {
+        std::cerr << "Error: " << argv[1] << " is not a telemetry file" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> names(n_cols);
+    for (auto& name : names) {
+        std::uint32_t size;
+        if (!readRaw(file, &size, 1)) return 1;
+        name.resize(size);
+        if (size && !readRaw(file, &name[0], size)) return 1;
+    }
+
+    std::cout << "# sample_every=" << every << " downsample=" << downsample << "\n";
+    std::cout << "cycle";
+    for (const auto& name : names) std::cout << "," << name << ".min," << name << ".max," << name << ".avg";
+    std::cout << "\n";
+
+    std::uint32_t rows;
+    while (readRaw(file, &rows, 1)) {
+        std::vector<std::uint64_t> cycles(rows);
+        std::vector<std::uint32_t> mins(std::size_t(rows) * n_cols), maxs(std::size_t(rows) * n_cols);
+        std::vector<float> avgs(std::size_t(rows) * n_cols);
+        if (!readRaw(file, cycles.data(), rows)) break;
+        for (std::uint32_t c = 0; c < n_cols; ++c) {
+            if (!readRaw(file, mins.data() + std::size_t(c) * rows, rows)
+                || !readRaw(file, maxs.data() + std::size_t(c) * rows, rows)
+                || !readRaw(file, avgs.data() + std::size_t(c) * rows, rows)) {
+                std::cerr << "Error: truncated block" << std::endl;
+                return 1;
+            }
+        }
+        for (std::uint32_t r = 0; r < rows; ++r) {
+            std::cout << cycles[r];
+            for (std::uint32_t c = 0; c < n_cols; ++c) {
+                std::size_t i = std::size_t(c) * rows + r;
+                std::cout << "," << mins[i] << "," << maxs[i] << "," << avgs[i];
+            }
+            std::cout << "\n";
+        }
+    }
+    return 0;
+}